@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#include "allocator.h"
+
+
+// Аллокатор, выравнивающий начало каждого блока на Alignment байт (32 — ширина AVX2,
+// 64 — строка кэша и ширина AVX-512). Размер блока округляется вверх до кратного Alignment,
+// поэтому память от начала блока до PaddedSize(size) элементов всегда доступна для чтения:
+// векторный цикл может дочитать последний неполный регистр без отдельного хвоста
+template <typename Type, size_t Alignment = 64>
+class AlignedAllocator {
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(Type), "Alignment must not be weaker than alignof(Type)");
+    static_assert(Alignment >= sizeof(void*), "aligned_alloc needs at least pointer alignment");
+
+public:
+    using value_type = Type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    // Нетиповой параметр шаблона не даёт allocator_traits вывести rebind самостоятельно.
+    // Для типов с более строгим выравниванием выравнивание усиливается до их alignof
+    template <typename Other>
+    struct rebind {
+        using other = AlignedAllocator<Other, std::max(Alignment, alignof(Other))>;
+    };
+
+    static constexpr size_t ALIGNMENT = Alignment;
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename Other, size_t OtherAlignment>
+    AlignedAllocator(const AlignedAllocator<Other, OtherAlignment>&) noexcept {
+    }
+
+    [[nodiscard]] Type* allocate(size_t size) {
+        if (size > std::numeric_limits<size_t>::max() / sizeof(Type) - Alignment) {
+            throw std::bad_alloc();
+        }
+        void* ptr = allocator_detail::AlignedAlloc(Alignment, PaddedBytes(size));
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<Type*>(ptr);
+    }
+
+    void deallocate(Type* ptr, size_t /*size*/) noexcept {
+        allocator_detail::AlignedFree(ptr);
+    }
+
+    // Сколько байт занимает блок под size элементов
+    static constexpr size_t PaddedBytes(size_t size) noexcept {
+        return (size * sizeof(Type) + Alignment - 1) / Alignment * Alignment;
+    }
+
+    // Сколько элементов целиком помещается в блок под size элементов
+    static constexpr size_t PaddedSize(size_t size) noexcept {
+        return PaddedBytes(size) / sizeof(Type);
+    }
+};
+
+template <typename Lhs, size_t LhsAlignment, typename Rhs, size_t RhsAlignment>
+inline bool operator==(const AlignedAllocator<Lhs, LhsAlignment>&, const AlignedAllocator<Rhs, RhsAlignment>&) noexcept {
+    return true;
+}
+
+template <typename Lhs, size_t LhsAlignment, typename Rhs, size_t RhsAlignment>
+inline bool operator!=(const AlignedAllocator<Lhs, LhsAlignment>&, const AlignedAllocator<Rhs, RhsAlignment>&) noexcept {
+    return false;
+}
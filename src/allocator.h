@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+
+namespace allocator_detail {
+
+// Блок из bytes байт (кратно alignment), выровненный на alignment, или nullptr.
+// В MSVC нет std::aligned_alloc: такие блоки выделяет _aligned_malloc
+inline void* AlignedAlloc(size_t alignment, size_t bytes) noexcept {
+#if defined(_MSC_VER)
+    return _aligned_malloc(bytes, alignment);
+#else
+    return std::aligned_alloc(alignment, bytes);
+#endif
+}
+
+// Освобождает блок AlignedAlloc: в MSVC он освобождается только _aligned_free
+inline void AlignedFree(void* ptr) noexcept {
+#if defined(_MSC_VER)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+}  // namespace allocator_detail
+
+// Аллокатор по умолчанию для ArrayPtr и SimpleVector. Совместим с std::allocator,
+// но выделяет память через malloc, поэтому умеет расширять блок на месте (reallocate).
+// При вычислении на этапе компиляции память берётся у std::allocator
+template <typename Type>
+class MallocAllocator {
+public:
+    using value_type = Type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    MallocAllocator() noexcept = default;
+
+    template <typename Other>
+    constexpr MallocAllocator(const MallocAllocator<Other>&) noexcept {
+    }
+
+    // Наибольшее число элементов, размер блока под которые (с округлением
+    // до выравнивания) ещё представим в size_t
+    constexpr size_t max_size() const noexcept {
+        return (std::numeric_limits<size_t>::max() - (alignof(Type) - 1)) / sizeof(Type);
+    }
+
+    // Выбрасывает std::bad_array_new_length, если size > max_size(),
+    // и std::bad_alloc при нехватке памяти
+    [[nodiscard]] constexpr Type* allocate(size_t size) {
+        if (std::is_constant_evaluated()) {
+            return std::allocator<Type>().allocate(size);
+        }
+        if (size > max_size()) {
+            throw std::bad_array_new_length();
+        }
+        void* ptr = nullptr;
+        if constexpr (alignof(Type) <= alignof(std::max_align_t)) {
+            ptr = std::malloc(size * sizeof(Type));
+        } else {
+            const size_t bytes = (size * sizeof(Type) + alignof(Type) - 1) / alignof(Type) * alignof(Type);
+            ptr = allocator_detail::AlignedAlloc(alignof(Type), bytes);
+        }
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<Type*>(ptr);
+    }
+
+    constexpr void deallocate(Type* ptr, size_t size) noexcept {
+        if (std::is_constant_evaluated()) {
+            std::allocator<Type>().deallocate(ptr, size);
+            return;
+        }
+        if constexpr (alignof(Type) <= alignof(std::max_align_t)) {
+            std::free(ptr);
+        } else {
+            allocator_detail::AlignedFree(ptr);
+        }
+    }
+
+    // Расширение интерфейса std::allocator: переносит блок из old_size элементов в блок
+    // из new_size элементов, по возможности не копируя. Содержимое переносится побайтово,
+    // поэтому вызывать метод можно только для тривиально перемещаемых типов.
+    // При нехватке памяти выбрасывает std::bad_alloc, а при new_size > max_size() —
+    // std::bad_array_new_length; старый блок в обоих случаях остаётся действительным
+    [[nodiscard]] Type* reallocate(Type* ptr, size_t old_size, size_t new_size) {
+        if (new_size > max_size()) {
+            throw std::bad_array_new_length();
+        }
+        if constexpr (alignof(Type) <= alignof(std::max_align_t)) {
+            void* new_ptr = std::realloc(static_cast<void*>(ptr), new_size * sizeof(Type));
+            if (new_ptr == nullptr) {
+                throw std::bad_alloc();
+            }
+            return static_cast<Type*>(new_ptr);
+        } else {
+            Type* new_ptr = allocate(new_size);
+            if (ptr != nullptr) {
+                std::memcpy(static_cast<void*>(new_ptr), static_cast<const void*>(ptr),
+                            std::min(old_size, new_size) * sizeof(Type));
+                deallocate(ptr, old_size);
+            }
+            return new_ptr;
+        }
+    }
+};
+
+template <typename Lhs, typename Rhs>
+constexpr bool operator==(const MallocAllocator<Lhs>&, const MallocAllocator<Rhs>&) noexcept {
+    return true;
+}
+
+template <typename Lhs, typename Rhs>
+constexpr bool operator!=(const MallocAllocator<Lhs>&, const MallocAllocator<Rhs>&) noexcept {
+    return false;
+}
+
+// Проверяет, поддерживает ли аллокатор расширение reallocate(ptr, old_size, new_size)
+template <typename Allocator, typename = void>
+struct HasReallocate : std::false_type {};
+
+template <typename Allocator>
+struct HasReallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().reallocate(
+        std::declval<typename Allocator::value_type*>(), size_t{}, size_t{}))>> : std::true_type {};
+
+template <typename Allocator>
+inline constexpr bool HasReallocateV = HasReallocate<Allocator>::value;
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+
+// Монотонная арена: память выдаётся сдвигом указателя внутри крупных блоков
+// и освобождается вся разом в Release или деструкторе. Отдельное освобождение
+// возвращает память, только если это последний выделенный блок.
+// Арена не потокобезопасна: заводите по арене на запрос/поток,
+// тогда выделения вообще не обращаются к общему malloc
+class MonotonicArena {
+public:
+    explicit MonotonicArena(size_t initial_block_size = 4096)
+        : next_block_size_(std::max(initial_block_size, MIN_BLOCK_SIZE)) {
+    }
+
+    // Использует внешний буфер (например, на стеке) как первый блок арены.
+    // Буфер арене не принадлежит и должен пережить её
+    MonotonicArena(void* buffer, size_t size)
+        : current_(static_cast<char*>(buffer)),
+          end_(static_cast<char*>(buffer) + size),
+          next_block_size_(std::max(size * 2, MIN_BLOCK_SIZE)) {
+    }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() {
+        FreeBlocks();
+    }
+
+    // Выделяет bytes байт с выравниванием alignment. Выбрасывает std::bad_array_new_length,
+    // если блок с заголовком и запасом на выравнивание не представим в size_t
+    [[nodiscard]] void* Allocate(size_t bytes, size_t alignment) {
+        if (bytes > std::numeric_limits<size_t>::max() - alignment - sizeof(BlockHeader)) {
+            throw std::bad_array_new_length();
+        }
+        char* ptr = AlignUp(current_, alignment);
+        if (current_ == nullptr || ptr > end_ || bytes > static_cast<size_t>(end_ - ptr)) {
+            AddBlock(bytes + alignment);
+            ptr = AlignUp(current_, alignment);
+        }
+        current_ = ptr + bytes;
+        last_allocation_ = ptr;
+        allocated_bytes_ += bytes;
+        return ptr;
+    }
+
+    // Меняет размер блока ptr. Последний выделенный блок растёт или сжимается на месте,
+    // остальные копируются в новый блок побайтово
+    [[nodiscard]] void* Reallocate(void* ptr, size_t old_bytes, size_t new_bytes, size_t alignment) {
+        if (ptr != nullptr && ptr == last_allocation_
+            && new_bytes <= static_cast<size_t>(end_ - static_cast<char*>(ptr))) {
+            current_ = static_cast<char*>(ptr) + new_bytes;
+            allocated_bytes_ = allocated_bytes_ - old_bytes + new_bytes;
+            return ptr;
+        }
+        void* new_ptr = Allocate(new_bytes, alignment);
+        if (ptr != nullptr) {
+            std::memcpy(new_ptr, ptr, std::min(old_bytes, new_bytes));
+        }
+        return new_ptr;
+    }
+
+    // Освобождение отдельного блока — no-op, кроме последнего выделенного,
+    // память которого сразу возвращается в арену
+    void Deallocate(void* ptr, size_t /*bytes*/) noexcept {
+        if (ptr != nullptr && ptr == last_allocation_) {
+            current_ = static_cast<char*>(ptr);
+            last_allocation_ = nullptr;
+        }
+    }
+
+    // Освобождает всю выделенную ареной память одним действием.
+    // Все указатели, выданные ареной, становятся недействительными
+    void Release() noexcept {
+        FreeBlocks();
+        current_ = nullptr;
+        end_ = nullptr;
+        last_allocation_ = nullptr;
+        allocated_bytes_ = 0;
+    }
+
+    // Возвращает суммарный объём выданной памяти с момента создания или Release
+    size_t GetAllocatedBytes() const noexcept {
+        return allocated_bytes_;
+    }
+
+private:
+    struct BlockHeader {
+        BlockHeader* next;
+    };
+
+    static constexpr size_t MIN_BLOCK_SIZE = 256;
+
+    static char* AlignUp(char* ptr, size_t alignment) noexcept {
+        const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+        return ptr + ((alignment - address % alignment) % alignment);
+    }
+
+    void AddBlock(size_t min_size) {
+        const size_t size = std::max(next_block_size_, min_size + sizeof(BlockHeader));
+        void* memory = std::malloc(size);
+        if (memory == nullptr) {
+            throw std::bad_alloc();
+        }
+        auto* header = static_cast<BlockHeader*>(memory);
+        header->next = blocks_;
+        blocks_ = header;
+        current_ = static_cast<char*>(memory) + sizeof(BlockHeader);
+        end_ = static_cast<char*>(memory) + size;
+        next_block_size_ = size * 2;
+    }
+
+    void FreeBlocks() noexcept {
+        while (blocks_ != nullptr) {
+            BlockHeader* next = blocks_->next;
+            std::free(blocks_);
+            blocks_ = next;
+        }
+    }
+
+    BlockHeader* blocks_ = nullptr;
+    char* current_ = nullptr;
+    char* end_ = nullptr;
+    void* last_allocation_ = nullptr;
+    size_t next_block_size_;
+    size_t allocated_bytes_ = 0;
+};
+
+// std-совместимый аллокатор поверх MonotonicArena. Копии аллокатора ссылаются
+// на одну арену, поэтому все векторы запроса берут память из одной области
+template <typename Type>
+class ArenaAllocator {
+public:
+    using value_type = Type;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit ArenaAllocator(MonotonicArena& arena) noexcept
+        : arena_(&arena) {
+    }
+
+    template <typename Other>
+    ArenaAllocator(const ArenaAllocator<Other>& other) noexcept
+        : arena_(other.GetArena()) {
+    }
+
+    constexpr size_t max_size() const noexcept {
+        return std::numeric_limits<size_t>::max() / sizeof(Type);
+    }
+
+    [[nodiscard]] Type* allocate(size_t size) {
+        if (size > max_size()) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<Type*>(arena_->Allocate(size * sizeof(Type), alignof(Type)));
+    }
+
+    void deallocate(Type* ptr, size_t size) noexcept {
+        arena_->Deallocate(ptr, size * sizeof(Type));
+    }
+
+    // См. MallocAllocator::reallocate: последний блок арены растёт на месте
+    [[nodiscard]] Type* reallocate(Type* ptr, size_t old_size, size_t new_size) {
+        if (new_size > max_size()) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<Type*>(arena_->Reallocate(ptr, old_size * sizeof(Type), new_size * sizeof(Type), alignof(Type)));
+    }
+
+    MonotonicArena* GetArena() const noexcept {
+        return arena_;
+    }
+
+private:
+    MonotonicArena* arena_;
+};
+
+template <typename Lhs, typename Rhs>
+inline bool operator==(const ArenaAllocator<Lhs>& lhs, const ArenaAllocator<Rhs>& rhs) noexcept {
+    return lhs.GetArena() == rhs.GetArena();
+}
+
+template <typename Lhs, typename Rhs>
+inline bool operator!=(const ArenaAllocator<Lhs>& lhs, const ArenaAllocator<Rhs>& rhs) noexcept {
+    return !(lhs == rhs);
+}
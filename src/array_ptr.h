@@ -1,28 +1,51 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
+#include "allocator.h"
+#include "relocation.h"
 
-template <typename Type>
+
+// Владеет сырой (неинициализированной) памятью под массив элементов типа Type,
+// полученной от аллокатора Allocator. ArrayPtr не создаёт и не разрушает элементы:
+// этим занимается владелец, например SimpleVector, который конструирует только
+// реально занятые ячейки
+template <typename Type, typename Allocator = MallocAllocator<Type>>
 class ArrayPtr {
+    using AllocTraits = std::allocator_traits<Allocator>;
+    static_assert(std::is_same_v<typename AllocTraits::value_type, Type>, "Allocator::value_type must be Type");
+    static_assert(std::is_same_v<typename AllocTraits::pointer, Type*>, "Allocator must use raw pointers");
+
 public:
     // Инициализирует ArrayPtr нулевым указателем
-    ArrayPtr() = default;
+    constexpr ArrayPtr() = default;
+
+    // Инициализирует ArrayPtr нулевым указателем и запоминает аллокатор
+    constexpr explicit ArrayPtr(const Allocator& alloc) noexcept
+        : alloc_(alloc) {
+    }
 
-    // Создаёт в куче массив из size элементов типа Type.
+    // Выделяет неинициализированную память под size элементов типа Type.
     // Если size == 0, поле raw_ptr_ должно быть равно nullptr
-    explicit ArrayPtr(size_t size) {
-        if (size == 0) {
-            ArrayPtr();
-        }
-        else {
-            raw_ptr_ = new Type[size];
+    constexpr explicit ArrayPtr(size_t size, const Allocator& alloc = Allocator())
+        : alloc_(alloc) {
+        if (size != 0) {
+            raw_ptr_ = AllocTraits::allocate(alloc_, size);
+            size_ = size;
         }
     }
 
-    // Конструктор из сырого указателя, хранящего адрес массива в куче либо nullptr
-    explicit ArrayPtr(Type* raw_ptr) noexcept {
+    // Конструктор из сырого указателя на память из size элементов, полученную ранее
+    // через Release у ArrayPtr с тем же аллокатором, либо nullptr
+    constexpr ArrayPtr(Type* raw_ptr, size_t size, const Allocator& alloc = Allocator()) noexcept
+        : alloc_(alloc) {
         raw_ptr_ = raw_ptr;
+        size_ = raw_ptr == nullptr ? 0 : size;
     }
 
     // Запрещаем копирование
@@ -31,55 +54,111 @@ public:
     // Запрещаем присваивание
     ArrayPtr& operator=(const ArrayPtr&) = delete;
 
-    ArrayPtr(ArrayPtr&& other) {
+    constexpr ArrayPtr(ArrayPtr&& other) noexcept
+        : alloc_(other.alloc_) {
         raw_ptr_ = std::exchange(other.raw_ptr_, nullptr);
+        size_ = std::exchange(other.size_, 0);
     }
 
-    ArrayPtr& operator=(ArrayPtr&& rhs) {
+    constexpr ArrayPtr& operator=(ArrayPtr&& rhs) noexcept {
         if (raw_ptr_ == rhs.raw_ptr_) {
             return *this;
         }
-        std::swap(raw_ptr_, rhs.raw_ptr_);
+        swap(rhs);
         return *this;
     }
 
-    ~ArrayPtr() {
-        delete[] raw_ptr_;
+    // Освобождает память. Элементы к этому моменту должны быть разрушены владельцем
+    constexpr ~ArrayPtr() {
+        if (raw_ptr_ != nullptr) {
+            AllocTraits::deallocate(alloc_, raw_ptr_, size_);
+        }
     }
 
     // Прекращает владением массивом в памяти, возвращает значение адреса массива
     // После вызова метода указатель на массив должен обнулиться
-    [[nodiscard]] Type* Release() noexcept {
+    [[nodiscard]] constexpr Type* Release() noexcept {
         Type* ptr = raw_ptr_;
         raw_ptr_ = nullptr;
+        size_ = 0;
         return ptr;
     }
 
     // Возвращает ссылку на элемент массива с индексом index
-    Type& operator[](size_t index) noexcept {
-        return *(raw_ptr_ + static_cast<int>(index));
+    constexpr Type& operator[](size_t index) noexcept {
+        return raw_ptr_[index];
     }
 
     // Возвращает константную ссылку на элемент массива с индексом index
-    const Type& operator[](size_t index) const noexcept {
-        return *(raw_ptr_ + static_cast<int>(index));
+    constexpr const Type& operator[](size_t index) const noexcept {
+        return raw_ptr_[index];
     }
 
     // Возвращает true, если указатель ненулевой, и false в противном случае
-    explicit operator bool() const {
+    constexpr explicit operator bool() const {
         return raw_ptr_ != nullptr;
     }
 
     // Возвращает значение сырого указателя, хранящего адрес начала массива
-    Type* Get() const noexcept {
+    constexpr Type* Get() const noexcept {
         return raw_ptr_;
     }
 
-    // Обменивается значениям указателя на массив с объектом other
-    void swap(ArrayPtr& other) noexcept {
+    // Возвращает количество элементов, под которые выделена память
+    constexpr size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает аллокатор, которым выделена память
+    constexpr const Allocator& GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    // Переносит массив в память под new_size элементов. Если аллокатор поддерживает
+    // reallocate, блок по возможности расширяется на месте.
+    // Первые min(size, new_size) элементов переносятся побайтово, поэтому метод
+    // доступен только для тривиально перемещаемых типов. Элементы за пределами new_size
+    // владелец должен разрушить заранее. Если выделение памяти выбросит исключение,
+    // массив останется нетронутым. На этапе компиляции элементы переносятся по одному
+    constexpr void Reallocate(size_t new_size) {
+        static_assert(IsTriviallyRelocatableV<Type>, "Reallocate requires a trivially relocatable type");
+        if (new_size == 0) {
+            ArrayPtr(alloc_).swap(*this);
+            return;
+        }
+        if (std::is_constant_evaluated()) {
+            ArrayPtr new_items(new_size, alloc_);
+            UninitializedRelocate(raw_ptr_, raw_ptr_ + std::min(size_, new_size), new_items.Get());
+            swap(new_items);
+            return;
+        }
+        if constexpr (HasReallocateV<Allocator>) {
+            raw_ptr_ = alloc_.reallocate(raw_ptr_, size_, new_size);
+        } else {
+            Type* new_ptr = AllocTraits::allocate(alloc_, new_size);
+            if (raw_ptr_ != nullptr) {
+                std::memcpy(static_cast<void*>(new_ptr), static_cast<const void*>(raw_ptr_),
+                            std::min(size_, new_size) * sizeof(Type));
+                AllocTraits::deallocate(alloc_, raw_ptr_, size_);
+            }
+            raw_ptr_ = new_ptr;
+        }
+        size_ = new_size;
+    }
+
+    // Обменивается значениям указателя на массив с объектом other. Аллокаторы
+    // обмениваются, если это разрешает propagate_on_container_swap, иначе они должны быть равны
+    constexpr void swap(ArrayPtr& other) noexcept {
         std::swap(raw_ptr_, other.raw_ptr_);
+        std::swap(size_, other.size_);
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+        }
     }
 
 private:
     Type* raw_ptr_ = nullptr;
+    size_t size_ = 0;
+    [[no_unique_address]] Allocator alloc_{};
 };
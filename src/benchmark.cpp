@@ -0,0 +1,938 @@
+// Бенчмарки SimpleVector в сравнении с std::vector.
+// Для каждой операции, типа элементов и размера печатается время на операцию,
+// число выделений памяти на операцию и объём скопированных/перемещённых элементов.
+// Копирования считают сами типы элементов (string и non-copyable); int переносится
+// memcpy/realloc внутри контейнеров, поэтому для него этот столбец всегда равен 0.
+//
+// Запуск: simple_vector_benchmark [--max-size N] [--filter OP] [--budget-ms T]
+//   --max-size N   наибольший размер вектора (по умолчанию 10^6, допустимо до 10^8)
+//   --filter OP    запускать только операции, в названии которых есть OP
+//   --budget-ms T  сколько времени повторять один замер (по умолчанию 100 мс)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "allocator.h"
+#include "concurrent_simple_vector.h"
+#include "cow_simple_vector.h"
+#include "flat_set.h"
+#include "segmented_vector.h"
+#include "simple_bit_vector.h"
+#include "soa_vector.h"
+#include "static_vector.h"
+#include "huge_page_allocator.h"
+#include "parallel_algorithms.h"
+#include "simple_vector.h"
+#include "small_simple_vector.h"
+#include "simple_vector_io.h"
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Счётчики
+
+struct Counters {
+    size_t allocations = 0;
+    size_t bytes_allocated = 0;
+    size_t bytes_copied = 0;
+};
+
+Counters g_counters;
+
+// Время, в течение которого повторяется один замер
+std::chrono::milliseconds g_budget{100};
+
+// Аллокатор, считающий выделения. Память берётся у MallocAllocator, так что
+// SimpleVector и std::vector работают с одним и тем же malloc
+template <typename Type>
+class CountingAllocator {
+public:
+    using value_type = Type;
+
+    CountingAllocator() noexcept = default;
+
+    template <typename Other>
+    CountingAllocator(const CountingAllocator<Other>&) noexcept {
+    }
+
+    Type* allocate(size_t size) {
+        ++g_counters.allocations;
+        g_counters.bytes_allocated += size * sizeof(Type);
+        return MallocAllocator<Type>().allocate(size);
+    }
+
+    void deallocate(Type* ptr, size_t size) noexcept {
+        MallocAllocator<Type>().deallocate(ptr, size);
+    }
+
+    Type* reallocate(Type* ptr, size_t old_size, size_t new_size) {
+        ++g_counters.allocations;
+        g_counters.bytes_allocated += new_size * sizeof(Type);
+        return MallocAllocator<Type>().reallocate(ptr, old_size, new_size);
+    }
+};
+
+template <typename Lhs, typename Rhs>
+bool operator==(const CountingAllocator<Lhs>&, const CountingAllocator<Rhs>&) noexcept {
+    return true;
+}
+
+template <typename Lhs, typename Rhs>
+bool operator!=(const CountingAllocator<Lhs>&, const CountingAllocator<Rhs>&) noexcept {
+    return false;
+}
+
+// Строка, считающая собственные копирования и перемещения
+class TrackedString {
+public:
+    TrackedString() = default;
+
+    explicit TrackedString(std::string value)
+        : value_(std::move(value)) {
+    }
+
+    TrackedString(const TrackedString& other)
+        : value_(other.value_) {
+        g_counters.bytes_copied += sizeof(TrackedString);
+    }
+
+    TrackedString(TrackedString&& other) noexcept
+        : value_(std::move(other.value_)) {
+        g_counters.bytes_copied += sizeof(TrackedString);
+    }
+
+    TrackedString& operator=(const TrackedString& other) {
+        value_ = other.value_;
+        g_counters.bytes_copied += sizeof(TrackedString);
+        return *this;
+    }
+
+    TrackedString& operator=(TrackedString&& other) noexcept {
+        value_ = std::move(other.value_);
+        g_counters.bytes_copied += sizeof(TrackedString);
+        return *this;
+    }
+
+    bool operator==(const TrackedString& other) const {
+        return value_ == other.value_;
+    }
+
+    bool operator<(const TrackedString& other) const {
+        return value_ < other.value_;
+    }
+
+private:
+    std::string value_;
+};
+
+// Некопируемый тип наподобие X из tests.h, считающий перемещения
+class MoveOnly {
+public:
+    MoveOnly()
+        : MoveOnly(5) {
+    }
+
+    explicit MoveOnly(size_t value)
+        : value_(value) {
+    }
+
+    MoveOnly(const MoveOnly&) = delete;
+    MoveOnly& operator=(const MoveOnly&) = delete;
+
+    MoveOnly(MoveOnly&& other)
+        : value_(std::exchange(other.value_, 0)) {
+        g_counters.bytes_copied += sizeof(MoveOnly);
+    }
+
+    MoveOnly& operator=(MoveOnly&& other) {
+        value_ = std::exchange(other.value_, 0);
+        g_counters.bytes_copied += sizeof(MoveOnly);
+        return *this;
+    }
+
+    bool operator==(const MoveOnly& other) const {
+        return value_ == other.value_;
+    }
+
+    bool operator<(const MoveOnly& other) const {
+        return value_ < other.value_;
+    }
+
+private:
+    size_t value_;
+};
+
+template <typename Type>
+Type MakeValue(size_t i) {
+    if constexpr (std::is_same_v<Type, TrackedString>) {
+        // Длиннее буфера малых строк, чтобы строка жила в куче
+        return TrackedString("benchmark-string-value-" + std::to_string(i));
+    } else {
+        return Type(i);
+    }
+}
+
+template <typename Type>
+const char* TypeName() {
+    if constexpr (std::is_same_v<Type, int>) {
+        return "int";
+    } else if constexpr (std::is_same_v<Type, TrackedString>) {
+        return "string";
+    } else {
+        return "non-copyable";
+    }
+}
+
+// Не даёт компилятору выбросить вычисление value
+template <typename Value>
+void DoNotOptimize(const Value& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Адаптеры контейнеров
+
+template <typename Type>
+struct SimpleVectorImpl {
+    using Vector = SimpleVector<Type, CountingAllocator<Type>>;
+    static constexpr const char* NAME = "SimpleVector";
+
+    static void PushBack(Vector& v, Type&& value) {
+        v.PushBack(std::move(value));
+    }
+    static void Insert(Vector& v, size_t index, Type&& value) {
+        v.Insert(v.begin() + index, std::move(value));
+    }
+    static void Erase(Vector& v, size_t index) {
+        v.Erase(v.begin() + index);
+    }
+    static void Resize(Vector& v, size_t size) {
+        v.Resize(size);
+    }
+    static void Reserve(Vector& v, size_t capacity) {
+        v.Reserve(capacity);
+    }
+    static size_t Size(const Vector& v) {
+        return v.GetSize();
+    }
+    static Type& Back(Vector& v) {
+        return v[v.GetSize() - 1];
+    }
+};
+
+template <typename Type>
+struct StdVectorImpl {
+    using Vector = std::vector<Type, CountingAllocator<Type>>;
+    static constexpr const char* NAME = "std::vector";
+
+    static void PushBack(Vector& v, Type&& value) {
+        v.push_back(std::move(value));
+    }
+    static void Insert(Vector& v, size_t index, Type&& value) {
+        v.insert(v.begin() + index, std::move(value));
+    }
+    static void Erase(Vector& v, size_t index) {
+        v.erase(v.begin() + index);
+    }
+    static void Resize(Vector& v, size_t size) {
+        v.resize(size);
+    }
+    static void Reserve(Vector& v, size_t capacity) {
+        v.reserve(capacity);
+    }
+    static size_t Size(const Vector& v) {
+        return v.size();
+    }
+    static Type& Back(Vector& v) {
+        return v.back();
+    }
+};
+
+template <typename Impl, typename Type>
+typename Impl::Vector MakeVector(size_t size) {
+    typename Impl::Vector v;
+    Impl::Reserve(v, size);
+    for (size_t i = 0; i < size; ++i) {
+        Impl::PushBack(v, MakeValue<Type>(i));
+    }
+    return v;
+}
+
+// ---------------------------------------------------------------------------
+// Замеры
+
+struct Measurement {
+    double ns_per_op = 0;
+    double allocations_per_op = 0;
+    double bytes_copied_per_op = 0;
+};
+
+// Сколько раз повторять замер, чтобы маленькие размеры не тонули в шуме
+size_t Repetitions(size_t size) {
+    return std::max<size_t>(1, 1'000'000 / std::max<size_t>(size, 1));
+}
+
+// Число вставок/удалений в середину вектора размера size: операция стоит O(size)
+size_t ShiftOperations(size_t size) {
+    return std::max<size_t>(1, std::min<size_t>(1000, 100'000'000 / std::max<size_t>(size, 1)));
+}
+
+// Вызывает prepare() (не замеряется), затем run(state) — не более repetitions раз
+// и не дольше g_budget. Счётчики учитываются только внутри run
+template <typename Prepare, typename Run>
+Measurement Measure(size_t repetitions, size_t ops_per_run, Prepare prepare, Run run) {
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + g_budget;
+    Clock::duration total{};
+    Counters counted;
+    size_t rep = 0;
+    for (; rep < repetitions && (rep == 0 || Clock::now() < deadline); ++rep) {
+        auto state = prepare();
+        g_counters = Counters{};
+        const auto start = Clock::now();
+        run(state);
+        total += Clock::now() - start;
+        counted.allocations += g_counters.allocations;
+        counted.bytes_copied += g_counters.bytes_copied;
+    }
+    const double ops = static_cast<double>(rep * ops_per_run);
+    Measurement result;
+    result.ns_per_op = std::chrono::duration<double, std::nano>(total).count() / ops;
+    result.allocations_per_op = counted.allocations / ops;
+    result.bytes_copied_per_op = counted.bytes_copied / ops;
+    return result;
+}
+
+template <typename Impl, typename Type>
+Measurement BenchPushBack(size_t size) {
+    return Measure(Repetitions(size), size, [] { return 0; }, [size](int) {
+        typename Impl::Vector v;
+        for (size_t i = 0; i < size; ++i) {
+            Impl::PushBack(v, MakeValue<Type>(i));
+        }
+        DoNotOptimize(Impl::Back(v));
+    });
+}
+
+template <typename Impl, typename Type>
+Measurement BenchInsert(size_t size) {
+    const size_t ops = ShiftOperations(size);
+    return Measure(Repetitions(size * ops / 100), ops, [size] { return MakeVector<Impl, Type>(size); },
+                   [ops](typename Impl::Vector& v) {
+        for (size_t i = 0; i < ops; ++i) {
+            Impl::Insert(v, Impl::Size(v) / 2, MakeValue<Type>(i));
+        }
+        DoNotOptimize(Impl::Back(v));
+    });
+}
+
+template <typename Impl, typename Type>
+Measurement BenchErase(size_t size) {
+    const size_t ops = std::min(size, ShiftOperations(size));
+    return Measure(Repetitions(size * ops / 100), ops, [size] { return MakeVector<Impl, Type>(size); },
+                   [ops](typename Impl::Vector& v) {
+        for (size_t i = 0; i < ops; ++i) {
+            Impl::Erase(v, Impl::Size(v) / 2);
+        }
+        DoNotOptimize(Impl::Size(v));
+    });
+}
+
+template <typename Impl, typename Type>
+Measurement BenchResize(size_t size) {
+    return Measure(Repetitions(size), size, [] { return 0; }, [size](int) {
+        typename Impl::Vector v;
+        Impl::Resize(v, size / 2);
+        Impl::Resize(v, size);
+        DoNotOptimize(Impl::Back(v));
+    });
+}
+
+template <typename Impl, typename Type>
+Measurement BenchReserve(size_t size) {
+    return Measure(Repetitions(size), 1, [size] { return MakeVector<Impl, Type>(size); },
+                   [size](typename Impl::Vector& v) {
+        Impl::Reserve(v, size * 2);
+        DoNotOptimize(Impl::Back(v));
+    });
+}
+
+template <typename Impl, typename Type>
+Measurement BenchCopyConstruct(size_t size) {
+    return Measure(Repetitions(size), 1, [size] { return MakeVector<Impl, Type>(size); },
+                   [](typename Impl::Vector& v) {
+        typename Impl::Vector copy(v);
+        DoNotOptimize(Impl::Back(copy));
+    });
+}
+
+template <typename Impl, typename Type>
+Measurement BenchMoveConstruct(size_t size) {
+    return Measure(Repetitions(size), 1, [size] { return MakeVector<Impl, Type>(size); },
+                   [](typename Impl::Vector& v) {
+        typename Impl::Vector moved(std::move(v));
+        DoNotOptimize(Impl::Back(moved));
+    });
+}
+
+template <typename Impl, typename Type>
+Measurement BenchCopyAssign(size_t size) {
+    return Measure(Repetitions(size), 1,
+                   [size] { return std::make_pair(MakeVector<Impl, Type>(size), MakeVector<Impl, Type>(size)); },
+                   [](auto& vectors) {
+        vectors.second = vectors.first;
+        DoNotOptimize(Impl::Back(vectors.second));
+    });
+}
+
+template <typename Impl, typename Type>
+Measurement BenchMoveAssign(size_t size) {
+    return Measure(Repetitions(size), 1,
+                   [size] { return std::make_pair(MakeVector<Impl, Type>(size), MakeVector<Impl, Type>(size)); },
+                   [](auto& vectors) {
+        vectors.second = std::move(vectors.first);
+        DoNotOptimize(Impl::Back(vectors.second));
+    });
+}
+
+template <typename Impl, typename Type>
+Measurement BenchEqual(size_t size) {
+    return Measure(Repetitions(size), 1,
+                   [size] { return std::make_pair(MakeVector<Impl, Type>(size), MakeVector<Impl, Type>(size)); },
+                   [](auto& vectors) {
+        const bool equal = vectors.first == vectors.second;
+        DoNotOptimize(equal);
+    });
+}
+
+template <typename Impl, typename Type>
+Measurement BenchLess(size_t size) {
+    return Measure(Repetitions(size), 1,
+                   [size] {
+        auto vectors = std::make_pair(MakeVector<Impl, Type>(size), MakeVector<Impl, Type>(size));
+        Impl::Back(vectors.second) = MakeValue<Type>(size);
+        return vectors;
+    },
+                   [](auto& vectors) {
+        const bool less = vectors.first < vectors.second;
+        DoNotOptimize(less);
+    });
+}
+
+// ---------------------------------------------------------------------------
+// Отчёт
+
+struct Options {
+    size_t max_size = 1'000'000;
+    std::string filter;
+};
+
+void PrintHeader() {
+    std::printf("%-14s %-13s %10s  %-13s %12s %12s %14s\n",
+                "operation", "type", "size", "container", "ns/op", "allocs/op", "bytes copied/op");
+}
+
+void PrintRow(const char* operation, const char* type, size_t size, const char* container, const Measurement& m) {
+    std::printf("%-14s %-13s %10zu  %-13s %12.2f %12.4f %14.1f\n",
+                operation, type, size, container, m.ns_per_op, m.allocations_per_op, m.bytes_copied_per_op);
+}
+
+template <template <typename, typename> typename Bench, typename Type>
+void RunComparison(const Options& options, const char* operation, size_t max_size) {
+    if (!options.filter.empty() && std::string(operation).find(options.filter) == std::string::npos) {
+        return;
+    }
+    for (size_t size = 1; size <= max_size; size *= 10) {
+        PrintRow(operation, TypeName<Type>(), size, SimpleVectorImpl<Type>::NAME,
+                 Bench<SimpleVectorImpl<Type>, Type>::Run(size));
+        PrintRow(operation, TypeName<Type>(), size, StdVectorImpl<Type>::NAME,
+                 Bench<StdVectorImpl<Type>, Type>::Run(size));
+    }
+}
+
+// Обёртки, позволяющие передавать шаблоны функций как шаблонные параметры
+#define SIMPLE_VECTOR_BENCH(NAME)                                   \
+    template <typename Impl, typename Type>                         \
+    struct NAME##Bench {                                            \
+        static Measurement Run(size_t size) {                       \
+            return Bench##NAME<Impl, Type>(size);                   \
+        }                                                           \
+    };
+
+SIMPLE_VECTOR_BENCH(PushBack)
+SIMPLE_VECTOR_BENCH(Insert)
+SIMPLE_VECTOR_BENCH(Erase)
+SIMPLE_VECTOR_BENCH(Resize)
+SIMPLE_VECTOR_BENCH(Reserve)
+SIMPLE_VECTOR_BENCH(CopyConstruct)
+SIMPLE_VECTOR_BENCH(MoveConstruct)
+SIMPLE_VECTOR_BENCH(CopyAssign)
+SIMPLE_VECTOR_BENCH(MoveAssign)
+SIMPLE_VECTOR_BENCH(Equal)
+SIMPLE_VECTOR_BENCH(Less)
+
+#undef SIMPLE_VECTOR_BENCH
+
+template <typename Type>
+void RunTypeBenchmarks(const Options& options, size_t max_size) {
+    RunComparison<PushBackBench, Type>(options, "PushBack", max_size);
+    RunComparison<InsertBench, Type>(options, "Insert", max_size);
+    RunComparison<EraseBench, Type>(options, "Erase", max_size);
+    RunComparison<ResizeBench, Type>(options, "Resize", max_size);
+    RunComparison<ReserveBench, Type>(options, "Reserve", max_size);
+    if constexpr (std::is_copy_constructible_v<Type>) {
+        RunComparison<CopyConstructBench, Type>(options, "CopyConstruct", max_size);
+        RunComparison<CopyAssignBench, Type>(options, "CopyAssign", max_size);
+    }
+    RunComparison<MoveConstructBench, Type>(options, "MoveConstruct", max_size);
+    RunComparison<MoveAssignBench, Type>(options, "MoveAssign", max_size);
+    RunComparison<EqualBench, Type>(options, "operator==", max_size);
+    RunComparison<LessBench, Type>(options, "operator<", max_size);
+}
+
+// Короткие векторы: создать, заполнить count элементами, разрушить
+template <typename Vector>
+Measurement BenchSmallFill(size_t count) {
+    constexpr size_t VECTORS = 100'000;
+    return Measure(1, VECTORS, [] { return 0; }, [count](int) {
+        for (size_t i = 0; i < VECTORS; ++i) {
+            Vector v;
+            for (size_t j = 0; j < count; ++j) {
+                v.PushBack(static_cast<int>(j));
+            }
+            DoNotOptimize(v[0]);
+        }
+    });
+}
+
+template <typename Type>
+struct StdVectorSmall : std::vector<Type, CountingAllocator<Type>> {
+    void PushBack(Type value) {
+        this->push_back(value);
+    }
+};
+
+void RunSmallVectorBenchmarks(const Options& options) {
+    if (!options.filter.empty() && std::string("SmallFill").find(options.filter) == std::string::npos) {
+        return;
+    }
+    for (size_t count : {1, 2, 4, 8, 16}) {
+        PrintRow("SmallFill", "int", count, "SimpleVector",
+                 BenchSmallFill<SimpleVector<int, CountingAllocator<int>>>(count));
+        PrintRow("SmallFill", "int", count, "Small<int,8>",
+                 BenchSmallFill<SmallSimpleVector<int, 8, CountingAllocator<int>>>(count));
+        PrintRow("SmallFill", "int", count, "StaticVector", BenchSmallFill<StaticVector<int, 16>>(count));
+        PrintRow("SmallFill", "int", count, "std::vector", BenchSmallFill<StdVectorSmall<int>>(count));
+    }
+}
+
+// Сравнение арифметических векторов: ядра simd_compare.h (операторы SimpleVector)
+// против поэлементных std::equal и std::lexicographical_compare. Векторы различаются
+// только последним элементом, так что просматриваются целиком
+template <typename Type>
+std::pair<SimpleVector<Type>, SimpleVector<Type>> MakeKernelInput(size_t size) {
+    std::pair<SimpleVector<Type>, SimpleVector<Type>> vectors{SimpleVector<Type>(size), SimpleVector<Type>(size)};
+    for (size_t i = 0; i < size; ++i) {
+        vectors.first[i] = vectors.second[i] = static_cast<Type>(i % 100);
+    }
+    if (size > 0) {
+        vectors.second[size - 1] = static_cast<Type>(100);
+    }
+    return vectors;
+}
+
+template <typename Type, typename Compare>
+Measurement BenchCompareKernel(size_t size, Compare compare) {
+    return Measure(Repetitions(size), 1, [size] { return MakeKernelInput<Type>(size); },
+                   [compare](auto& vectors) {
+        const bool result = compare(vectors.first, vectors.second);
+        DoNotOptimize(result);
+    });
+}
+
+template <typename Type>
+void RunCompareKernelBenchmarks(const Options& options, const char* type) {
+    using Vector = SimpleVector<Type>;
+    const auto simd_equal = [](const Vector& lhs, const Vector& rhs) {
+        return lhs == rhs;
+    };
+    const auto generic_equal = [](const Vector& lhs, const Vector& rhs) {
+        return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    };
+    const auto simd_less = [](const Vector& lhs, const Vector& rhs) {
+        return lhs < rhs;
+    };
+    const auto generic_less = [](const Vector& lhs, const Vector& rhs) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    };
+    for (size_t size = 1; size <= options.max_size; size *= 10) {
+        if (options.filter.empty() || std::string("Kernel==").find(options.filter) != std::string::npos) {
+            PrintRow("Kernel==", type, size, "simd", BenchCompareKernel<Type>(size, simd_equal));
+            PrintRow("Kernel==", type, size, "generic", BenchCompareKernel<Type>(size, generic_equal));
+        }
+        if (options.filter.empty() || std::string("Kernel<").find(options.filter) != std::string::npos) {
+            PrintRow("Kernel<", type, size, "simd", BenchCompareKernel<Type>(size, simd_less));
+            PrintRow("Kernel<", type, size, "generic", BenchCompareKernel<Type>(size, generic_less));
+        }
+    }
+}
+
+// Построение и заполнение больших векторов в одном потоке и на пуле потоков
+void RunParallelBenchmarks(const Options& options) {
+    const char* container = "SimpleVector";
+    const char* parallel = "parallel";
+    for (size_t size = 1000; size <= options.max_size; size *= 10) {
+        if (options.filter.empty() || std::string("Construct(n)").find(options.filter) != std::string::npos) {
+            PrintRow("Construct(n)", "double", size, container, Measure(Repetitions(size), 1, [] { return 0; }, [size](int) {
+                SimpleVector<double> v(size);
+                DoNotOptimize(v[size - 1]);
+            }));
+            PrintRow("Construct(n)", "double", size, parallel, Measure(Repetitions(size), 1, [] { return 0; }, [size](int) {
+                SimpleVector<double> v;
+                ParallelResize(v, size);
+                DoNotOptimize(v[size - 1]);
+            }));
+        }
+        if (options.filter.empty() || std::string("Fill").find(options.filter) != std::string::npos) {
+            const auto prepare = [size] { return SimpleVector<double>(size); };
+            PrintRow("Fill", "double", size, container, Measure(Repetitions(size), 1, prepare, [](SimpleVector<double>& v) {
+                std::fill(v.begin(), v.end(), 1.0);
+                DoNotOptimize(v[0]);
+            }));
+            PrintRow("Fill", "double", size, parallel, Measure(Repetitions(size), 1, prepare, [](SimpleVector<double>& v) {
+                ParallelFill(v, 1.0);
+                DoNotOptimize(v[0]);
+            }));
+        }
+    }
+}
+
+// Заполнение больших векторов PushBack-ом: malloc/realloc против mmap/mremap с большими страницами
+template <typename Vector>
+Measurement BenchLargePushBack(size_t size) {
+    return Measure(Repetitions(size), size, [] { return 0; }, [size](int) {
+        Vector v;
+        for (size_t i = 0; i < size; ++i) {
+            v.PushBack(i);
+        }
+        DoNotOptimize(v[size - 1]);
+    });
+}
+
+void RunHugePageBenchmarks(const Options& options) {
+    if (!options.filter.empty() && std::string("LargePushBack").find(options.filter) == std::string::npos) {
+        return;
+    }
+    for (size_t size = 1000; size <= options.max_size; size *= 10) {
+        PrintRow("LargePushBack", "uint64_t", size, "malloc", BenchLargePushBack<SimpleVector<uint64_t>>(size));
+        PrintRow("LargePushBack", "uint64_t", size, "huge pages",
+                 BenchLargePushBack<SimpleVector<uint64_t, HugePageAllocator<uint64_t>>>(size));
+    }
+}
+
+// Приём потока чисел: чтение по элементу с PushBack против ReadFrom в хвост вектора
+void RunIngestBenchmarks(const Options& options) {
+    if (!options.filter.empty() && std::string("Ingest").find(options.filter) == std::string::npos) {
+        return;
+    }
+    for (size_t size = 1; size <= options.max_size; size *= 10) {
+        std::string data(size * sizeof(uint32_t), '\x5a');
+        const auto prepare = [&data] { return std::istringstream(data); };
+        PrintRow("Ingest", "uint32_t", size, "PushBack", Measure(Repetitions(size), size, prepare, [size](std::istringstream& in) {
+            SimpleVector<uint32_t> v;
+            uint32_t value;
+            for (size_t i = 0; i < size && in.read(reinterpret_cast<char*>(&value), sizeof(value)); ++i) {
+                v.PushBack(value);
+            }
+            DoNotOptimize(v[0]);
+        }));
+        PrintRow("Ingest", "uint32_t", size, "ReadFrom", Measure(Repetitions(size), size, prepare, [size](std::istringstream& in) {
+            SimpleVector<uint32_t> v;
+            ReadFrom(in, v, size);
+            DoNotOptimize(v[0]);
+        }));
+    }
+}
+
+// Одновременное добавление из threads потоков: ConcurrentSimpleVector против SimpleVector под мьютексом.
+// Время — на один добавленный элемент, суммарно по всем потокам
+template <typename Push>
+Measurement BenchConcurrentPush(size_t threads, size_t per_thread, Push push) {
+    return Measure(1, threads * per_thread, [] { return 0; }, [threads, per_thread, &push](int) {
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([per_thread, &push] {
+                for (size_t i = 0; i < per_thread; ++i) {
+                    push(i);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    });
+}
+
+void RunConcurrentBenchmarks(const Options& options) {
+    if (!options.filter.empty() && std::string("ConcurrentPush").find(options.filter) == std::string::npos) {
+        return;
+    }
+    const size_t total = std::min<size_t>(options.max_size, 10'000'000);
+    for (size_t threads = 1; threads <= 64; threads *= 2) {
+        const size_t per_thread = std::max<size_t>(1, total / threads);
+        {
+            ConcurrentSimpleVector<uint64_t> v;
+            PrintRow("ConcurrentPush", "uint64_t", threads, "concurrent", BenchConcurrentPush(threads, per_thread, [&v](size_t i) {
+                v.PushBack(i);
+            }));
+        }
+        {
+            std::mutex mutex;
+            SimpleVector<uint64_t> v;
+            PrintRow("ConcurrentPush", "uint64_t", threads, "mutex", BenchConcurrentPush(threads, per_thread, [&](size_t i) {
+                std::lock_guard lock(mutex);
+                v.PushBack(i);
+            }));
+        }
+    }
+}
+
+// Задержка одного PushBack: у SimpleVector редкие добавления переносят весь массив,
+// SegmentedVector только добавляет сегмент. В столбце ns/op — 99-й перцентиль или максимум
+template <typename Vector>
+std::pair<Measurement, Measurement> BenchAppendLatency(size_t size) {
+    using Clock = std::chrono::steady_clock;
+    std::vector<double> latencies(size);
+    Vector v;
+    for (size_t i = 0; i < size; ++i) {
+        const auto start = Clock::now();
+        v.PushBack(i);
+        latencies[i] = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+    DoNotOptimize(v[size - 1]);
+    std::sort(latencies.begin(), latencies.end());
+    std::pair<Measurement, Measurement> result;
+    result.first.ns_per_op = latencies[size * 99 / 100];
+    result.second.ns_per_op = latencies.back();
+    return result;
+}
+
+void RunSegmentedBenchmarks(const Options& options) {
+    if (!options.filter.empty() && std::string("AppendLatency").find(options.filter) == std::string::npos) {
+        return;
+    }
+    for (size_t size = 1000; size <= options.max_size; size *= 10) {
+        const auto simple = BenchAppendLatency<SimpleVector<uint64_t>>(size);
+        const auto segmented = BenchAppendLatency<SegmentedVector<uint64_t>>(size);
+        PrintRow("AppendLatency", "p99", size, "SimpleVector", simple.first);
+        PrintRow("AppendLatency", "p99", size, "Segmented", segmented.first);
+        PrintRow("AppendLatency", "max", size, "SimpleVector", simple.second);
+        PrintRow("AppendLatency", "max", size, "Segmented", segmented.second);
+    }
+}
+
+// Сумма одного поля записи из 32 байт: массив структур читает все байты записей,
+// SoAVector — только массив поля
+struct ScanRecord {
+    uint64_t id;
+    double price;
+    uint32_t quantity;
+    uint32_t side;
+    uint64_t timestamp;
+};
+
+void RunFieldScanBenchmarks(const Options& options) {
+    if (!options.filter.empty() && std::string("FieldScan").find(options.filter) == std::string::npos) {
+        return;
+    }
+    // Записи занимают 32 байта, поэтому размер ограничен 10^7
+    for (size_t size = 1000; size <= std::min<size_t>(options.max_size, 10'000'000); size *= 10) {
+        {
+            SimpleVector<ScanRecord> records;
+            records.Reserve(size);
+            for (size_t i = 0; i < size; ++i) {
+                records.PushBack({i, static_cast<double>(i % 100), static_cast<uint32_t>(i), 0, i});
+            }
+            PrintRow("FieldScan", "price", size, "SimpleVector", Measure(Repetitions(size), size, [] { return 0; }, [&records](int) {
+                double sum = 0;
+                for (const ScanRecord& record : records) {
+                    sum += record.price;
+                }
+                DoNotOptimize(sum);
+            }));
+        }
+        {
+            SoAVector<uint64_t, double, uint32_t, uint32_t, uint64_t> records;
+            records.Reserve(size);
+            for (size_t i = 0; i < size; ++i) {
+                records.EmplaceBack(i, static_cast<double>(i % 100), static_cast<uint32_t>(i), 0u, i);
+            }
+            PrintRow("FieldScan", "price", size, "SoAVector", Measure(Repetitions(size), size, [] { return 0; }, [&records](int) {
+                double sum = 0;
+                for (double price : records.Field<1>()) {
+                    sum += price;
+                }
+                DoNotOptimize(sum);
+            }));
+        }
+    }
+}
+
+// Снимок таблицы: копия SimpleVector копирует элементы, копия CowSimpleVector — только указатель
+void RunSnapshotBenchmarks(const Options& options) {
+    if (!options.filter.empty() && std::string("Snapshot").find(options.filter) == std::string::npos) {
+        return;
+    }
+    for (size_t size = 1; size <= options.max_size; size *= 10) {
+        const SimpleVector<int> table(size, 1);
+        const CowSimpleVector<int> cow_table{SimpleVector<int>(table)};
+        constexpr size_t SNAPSHOTS = 100;
+        PrintRow("Snapshot", "int", size, "SimpleVector", Measure(Repetitions(size), SNAPSHOTS, [] { return 0; }, [&table](int) {
+            for (size_t i = 0; i < SNAPSHOTS; ++i) {
+                SimpleVector<int> copy(table);
+                DoNotOptimize(copy[0]);
+            }
+        }));
+        PrintRow("Snapshot", "int", size, "Cow", Measure(Repetitions(size), SNAPSHOTS, [] { return 0; }, [&cow_table](int) {
+            for (size_t i = 0; i < SNAPSHOTS; ++i) {
+                CowSimpleVector<int> copy(cow_table);
+                DoNotOptimize(copy.GetItems()[0]);
+            }
+        }));
+    }
+}
+
+// Пропускная способность поиска в FlatSet<int32_t> с разными раскладками:
+// случайные ключи, половина из которых есть в множестве
+template <typename Layout>
+Measurement BenchFlatLookup(const SimpleVector<int32_t>& keys, const std::vector<int32_t>& probes) {
+    const FlatSet<int32_t, std::less<int32_t>, Layout> set{SimpleVector<int32_t>(keys)};
+    return Measure(3, probes.size(), [] { return 0; }, [&set, &probes](int) {
+        size_t found = 0;
+        for (int32_t probe : probes) {
+            found += set.Contains(probe) ? 1 : 0;
+        }
+        DoNotOptimize(found);
+    });
+}
+
+void RunFlatLookupBenchmarks(const Options& options) {
+    if (!options.filter.empty() && std::string("FlatLookup").find(options.filter) == std::string::npos) {
+        return;
+    }
+    std::mt19937 generator(7);
+    for (size_t size = 1000; size <= options.max_size; size *= 10) {
+        SimpleVector<int32_t> keys;
+        keys.Reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            keys.PushBack(static_cast<int32_t>(i * 2));
+        }
+        std::vector<int32_t> probes(1 << 20);
+        for (int32_t& probe : probes) {
+            probe = static_cast<int32_t>(generator() % (size * 2));
+        }
+        PrintRow("FlatLookup", "int32_t", size, "Sorted", BenchFlatLookup<SortedLayout>(keys, probes));
+        PrintRow("FlatLookup", "int32_t", size, "Eytzinger", BenchFlatLookup<EytzingerLayout>(keys, probes));
+        PrintRow("FlatLookup", "int32_t", size, "BTree", BenchFlatLookup<BTreeLayout<>>(keys, probes));
+    }
+}
+
+// Пересечение и подсчёт флагов: SimpleVector<bool> по байту на флаг и SimpleBitVector по 64 флага в слове.
+// В столбце ns/op — время на один флаг
+void RunBitVectorBenchmarks(const Options& options) {
+    for (const char* operation : {"BitAnd", "BitCount"}) {
+        if (!options.filter.empty() && std::string(operation).find(options.filter) == std::string::npos) {
+            continue;
+        }
+        const bool count = std::string(operation) == "BitCount";
+        for (size_t size = 1000; size <= options.max_size; size *= 10) {
+            SimpleVector<bool> bytes_lhs(size), bytes_rhs(size);
+            SimpleBitVector<> bits_lhs(size), bits_rhs(size);
+            for (size_t i = 0; i < size; ++i) {
+                bytes_lhs[i] = bits_lhs[i] = i % 3 == 0;
+                bytes_rhs[i] = bits_rhs[i] = i % 5 == 0;
+            }
+            PrintRow(operation, "bool", size, "SimpleVector", Measure(Repetitions(size), size, [] { return 0; }, [&](int) {
+                size_t result = 0;
+                for (size_t i = 0; i < size; ++i) {
+                    if (count) {
+                        result += bytes_lhs[i];
+                    } else {
+                        bytes_lhs[i] = bytes_lhs[i] & bytes_rhs[i];
+                    }
+                }
+                DoNotOptimize(result);
+                DoNotOptimize(bytes_lhs[0]);
+            }));
+            PrintRow(operation, "bool", size, "BitVector", Measure(Repetitions(size), size, [] { return 0; }, [&](int) {
+                if (count) {
+                    DoNotOptimize(bits_lhs.Count());
+                } else {
+                    bits_lhs &= bits_rhs;
+                    DoNotOptimize(bits_lhs.GetWords()[0]);
+                }
+            }));
+        }
+    }
+}
+
+Options ParseOptions(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--max-size") == 0 && i + 1 < argc) {
+            options.max_size = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--budget-ms") == 0 && i + 1 < argc) {
+            g_budget = std::chrono::milliseconds(std::strtoull(argv[++i], nullptr, 10));
+        } else {
+            std::fprintf(stderr, "usage: %s [--max-size N] [--filter OP] [--budget-ms T]\n", argv[0]);
+            std::exit(2);
+        }
+    }
+    return options;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const Options options = ParseOptions(argc, argv);
+    PrintHeader();
+    RunTypeBenchmarks<int>(options, options.max_size);
+    // Строки и некопируемые объекты занимают больше памяти, поэтому их размеры ограничены 10^7
+    RunTypeBenchmarks<TrackedString>(options, std::min<size_t>(options.max_size, 10'000'000));
+    RunTypeBenchmarks<MoveOnly>(options, std::min<size_t>(options.max_size, 10'000'000));
+    RunSmallVectorBenchmarks(options);
+    RunCompareKernelBenchmarks<uint8_t>(options, "uint8_t");
+    RunCompareKernelBenchmarks<int32_t>(options, "int32_t");
+    RunCompareKernelBenchmarks<float>(options, "float");
+    RunParallelBenchmarks(options);
+    RunHugePageBenchmarks(options);
+    RunIngestBenchmarks(options);
+    RunSegmentedBenchmarks(options);
+    RunFieldScanBenchmarks(options);
+    RunSnapshotBenchmarks(options);
+    RunFlatLookupBenchmarks(options);
+    RunBitVectorBenchmarks(options);
+    // Для ConcurrentPush в столбце size — число потоков
+    RunConcurrentBenchmarks(options);
+    return 0;
+}
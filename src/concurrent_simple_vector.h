@@ -0,0 +1,252 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.h"
+#include "array_ptr.h"
+#include "geometric_segments.h"
+#include "index_iterator.h"
+
+
+// Вектор для одновременного добавления из многих потоков.
+// Элементы лежат в корзинах, размеры которых растут степенями двойки (32, 64, 128, ...),
+// корзины никогда не перевыделяются, поэтому адреса элементов не меняются.
+// PushBack/EmplaceBack не блокируются: корзина при необходимости создаётся с CAS,
+// индекс в ней резервируется CAS, элемент конструируется на месте и публикуется флагом.
+// GetSize() — длина начала вектора, все элементы которого опубликованы; чтение
+// таких элементов по индексу не ждёт других потоков.
+// Clear, Reserve и разрушение нельзя выполнять одновременно с другими операциями
+template <typename Type, typename Allocator = MallocAllocator<Type>>
+class ConcurrentSimpleVector {
+    using Buckets = GeometricSegments<5>;
+
+public:
+    using Iterator = IndexIterator<ConcurrentSimpleVector, Type>;
+    using ConstIterator = IndexIterator<const ConcurrentSimpleVector, const Type>;
+
+    ConcurrentSimpleVector() = default;
+
+    explicit ConcurrentSimpleVector(const Allocator& alloc)
+        : alloc_(alloc) {
+    }
+
+    ConcurrentSimpleVector(const ConcurrentSimpleVector&) = delete;
+    ConcurrentSimpleVector& operator=(const ConcurrentSimpleVector&) = delete;
+
+    ~ConcurrentSimpleVector() {
+        Clear();
+        for (auto& bucket : buckets_) {
+            delete bucket.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Добавляет элемент в конец и возвращает ссылку на него. Потокобезопасно.
+    // Если конструктор из args может бросить исключение, элемент сначала создаётся
+    // во временном объекте и затем перемещается в зарезервированную ячейку,
+    // чтобы ячейка никогда не осталась пустой
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if constexpr (std::is_nothrow_constructible_v<Type, Args&&...>) {
+            return Publish(ReserveSlot(), std::forward<Args>(args)...);
+        } else {
+            static_assert(std::is_nothrow_move_constructible_v<Type>,
+                          "ConcurrentSimpleVector needs a non-throwing constructor or move constructor");
+            Type item(std::forward<Args>(args)...);
+            return Publish(ReserveSlot(), std::move(item));
+        }
+    }
+
+    Type& PushBack(const Type& item) {
+        return EmplaceBack(item);
+    }
+
+    Type& PushBack(Type&& item) {
+        return EmplaceBack(std::move(item));
+    }
+
+    // Возвращает ссылку на опубликованный элемент (index < GetSize())
+    Type& operator[](size_t index) noexcept {
+        assert(index < GetSize());
+        const auto [bucket, offset] = Locate(index);
+        return buckets_[bucket].load(std::memory_order_acquire)->items.Get()[offset];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < GetSize());
+        const auto [bucket, offset] = Locate(index);
+        return buckets_[bucket].load(std::memory_order_acquire)->items.Get()[offset];
+    }
+
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("");
+        }
+        return (*this)[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("");
+        }
+        return (*this)[index];
+    }
+
+    // Число опубликованных элементов без пропусков
+    size_t GetSize() const noexcept {
+        return published_.load(std::memory_order_acquire);
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Суммарный размер созданных корзин
+    size_t GetCapacity() const noexcept {
+        size_t capacity = 0;
+        for (size_t bucket = 0; bucket < Buckets::MAX_COUNT; ++bucket) {
+            if (buckets_[bucket].load(std::memory_order_acquire) != nullptr) {
+                capacity += Buckets::SegmentSize(bucket);
+            }
+        }
+        return capacity;
+    }
+
+    // Заранее создаёт корзины для capacity элементов, чтобы добавление не выделяло память
+    void Reserve(size_t capacity) {
+        if (capacity == 0) {
+            return;
+        }
+        const size_t last_bucket = Locate(capacity - 1).first;
+        for (size_t bucket = 0; bucket <= last_bucket; ++bucket) {
+            GetOrCreateBucket(bucket);
+        }
+    }
+
+    // Разрушает элементы, оставляя корзины для повторного использования
+    void Clear() noexcept {
+        const size_t size = reserved_.load(std::memory_order_relaxed);
+        for (size_t index = 0; index < size; ++index) {
+            const auto [bucket, offset] = Locate(index);
+            Bucket* items = buckets_[bucket].load(std::memory_order_relaxed);
+            if (items != nullptr && items->ready.Get()[offset].load(std::memory_order_relaxed)) {
+                std::destroy_at(items->items.Get() + offset);
+                items->ready.Get()[offset].store(false, std::memory_order_relaxed);
+            }
+        }
+        reserved_.store(0, std::memory_order_relaxed);
+        published_.store(0, std::memory_order_relaxed);
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, GetSize());
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, GetSize());
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    using FlagAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::atomic<bool>>;
+
+    // Корзина: сырая память элементов и флаги их публикации
+    struct Bucket {
+        Bucket(size_t size, const Allocator& alloc)
+            : items(size, alloc),
+              ready(size, FlagAllocator(alloc)) {
+            std::uninitialized_value_construct_n(ready.Get(), size);
+        }
+
+        ArrayPtr<Type, Allocator> items;
+        ArrayPtr<std::atomic<bool>, FlagAllocator> ready;
+    };
+
+    static std::pair<size_t, size_t> Locate(size_t index) noexcept {
+        return Buckets::Locate(index);
+    }
+
+    Bucket* GetOrCreateBucket(size_t bucket) {
+        Bucket* existing = buckets_[bucket].load(std::memory_order_acquire);
+        if (existing != nullptr) {
+            return existing;
+        }
+        // Несколько потоков могут одновременно создать корзину; остаётся первая, остальные удаляются
+        auto created = std::make_unique<Bucket>(Buckets::SegmentSize(bucket), alloc_);
+        if (buckets_[bucket].compare_exchange_strong(existing, created.get(), std::memory_order_acq_rel)) {
+            return created.release();
+        }
+        return existing;
+    }
+
+    // Резервирует следующую ячейку. Корзина ячейки создаётся до того, как индекс
+    // будет занят: если выделение памяти бросит исключение, ни одна ячейка не пропадёт
+    // и граница опубликованных элементов не застрянет перед ней
+    size_t ReserveSlot() {
+        size_t index = reserved_.load(std::memory_order_relaxed);
+        while (true) {
+            GetOrCreateBucket(Locate(index).first);
+            if (reserved_.compare_exchange_weak(index, index + 1, std::memory_order_relaxed)) {
+                return index;
+            }
+        }
+    }
+
+    // Конструирует элемент в зарезервированной ячейке index и публикует его.
+    // Корзина уже создана, а конструктор не бросает исключений, поэтому ячейка
+    // всегда заполняется
+    template <typename... Args>
+    Type& Publish(size_t index, Args&&... args) noexcept {
+        const auto [bucket_index, offset] = Locate(index);
+        Bucket* bucket = buckets_[bucket_index].load(std::memory_order_acquire);
+        Type* item = new (bucket->items.Get() + offset) Type(std::forward<Args>(args)...);
+        bucket->ready.Get()[offset].store(true, std::memory_order_seq_cst);
+        AdvancePublished();
+        return *item;
+    }
+
+    bool IsReady(size_t index) const noexcept {
+        const auto [bucket, offset] = Locate(index);
+        const Bucket* items = buckets_[bucket].load(std::memory_order_acquire);
+        return items != nullptr && items->ready.Get()[offset].load(std::memory_order_seq_cst);
+    }
+
+    // Сдвигает границу опубликованного начала через все готовые ячейки. Поток, опубликовавший
+    // ячейку, которая не примыкает к границе, останавливается; границу протолкнёт поток,
+    // заполнивший пропуск. Флаг и граница читаются в seq_cst, поэтому хотя бы один из двух
+    // потоков увидит запись другого и ни одна готовая ячейка не будет пропущена
+    void AdvancePublished() noexcept {
+        size_t published = published_.load(std::memory_order_seq_cst);
+        while (published < reserved_.load(std::memory_order_seq_cst) && IsReady(published)) {
+            if (published_.compare_exchange_weak(published, published + 1, std::memory_order_seq_cst)) {
+                ++published;
+            }
+        }
+    }
+
+    [[no_unique_address]] Allocator alloc_{};
+    std::array<std::atomic<Bucket*>, Buckets::MAX_COUNT> buckets_{};
+    std::atomic<size_t> reserved_{0};
+    std::atomic<size_t> published_{0};
+};
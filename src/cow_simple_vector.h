@@ -0,0 +1,342 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "allocator.h"
+#include "simple_vector.h"
+
+
+// Вектор с копированием при записи. Копии разделяют один буфер со счётчиком ссылок,
+// поэтому копирование стоит O(1) и не выделяет память. Первая изменяющая операция
+// (неконстантные operator[], At, begin/end, PushBack, Insert, Erase, Resize, ...) над вектором,
+// буфер которого разделён с другими копиями, сначала клонирует буфер (Detach).
+// Счётчик ссылок атомарный: разные копии можно читать и изменять из разных потоков,
+// один и тот же объект — нет.
+// Как и строки с копированием при записи, вектор, выдавший изменяемую ссылку или итератор
+// (неконстантные operator[], At, begin/end, EmplaceBack, Insert, Erase), помечает буфер
+// неразделяемым: следующее копирование клонирует его, и запись через выданную ссылку
+// не меняет копии. Буфер снова становится разделяемым, когда ссылки на него
+// перестают действовать — после перевыделения памяти или Clear
+template <typename Type, typename Allocator = MallocAllocator<Type>>
+class CowSimpleVector {
+    using Items = SimpleVector<Type, Allocator>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    CowSimpleVector() noexcept = default;
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    explicit CowSimpleVector(size_t size)
+        : buffer_(size == 0 ? nullptr : new Buffer(size)) {
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    CowSimpleVector(size_t size, const Type& value)
+        : buffer_(size == 0 ? nullptr : new Buffer(size, value)) {
+    }
+
+    CowSimpleVector(std::initializer_list<Type> init)
+        : buffer_(init.size() == 0 ? nullptr : new Buffer(init)) {
+    }
+
+    // Забирает содержимое обычного вектора без копирования элементов
+    explicit CowSimpleVector(Items&& items)
+        : buffer_(new Buffer(std::move(items))) {
+    }
+
+    // Разделяет буфер other: O(1), без выделения памяти. Буфер, на который other
+    // выдал изменяемые ссылки, клонируется
+    CowSimpleVector(const CowSimpleVector& other) {
+        if (other.buffer_ == nullptr) {
+            return;
+        }
+        if (other.buffer_->shareable) {
+            buffer_ = other.buffer_;
+            buffer_->refs.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            buffer_ = new Buffer(other.buffer_->items);
+        }
+    }
+
+    CowSimpleVector(CowSimpleVector&& other) noexcept
+        : buffer_(std::exchange(other.buffer_, nullptr)) {
+    }
+
+    CowSimpleVector& operator=(const CowSimpleVector& rhs) {
+        CowSimpleVector copy(rhs);
+        swap(copy);
+        return *this;
+    }
+
+    CowSimpleVector& operator=(CowSimpleVector&& rhs) noexcept {
+        CowSimpleVector moved(std::move(rhs));
+        swap(moved);
+        return *this;
+    }
+
+    ~CowSimpleVector() {
+        Release();
+    }
+
+    // Делает буфер собственным: если он разделён с другими копиями, клонирует его
+    void Detach() {
+        if (buffer_ != nullptr && IsShared()) {
+            auto* clone = new Buffer(buffer_->items);
+            Release();
+            buffer_ = clone;
+        }
+    }
+
+    // Разделяет ли вектор буфер с другими копиями
+    bool IsShared() const noexcept {
+        return buffer_ != nullptr && buffer_->refs.load(std::memory_order_acquire) > 1;
+    }
+
+    // Число копий, разделяющих буфер (0 для пустого вектора без буфера)
+    size_t GetUseCount() const noexcept {
+        return buffer_ == nullptr ? 0 : buffer_->refs.load(std::memory_order_acquire);
+    }
+
+    // Содержимое в виде обычного SimpleVector, без копирования
+    const Items& GetItems() const noexcept {
+        return buffer_ == nullptr ? EmptyItems() : buffer_->items;
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < GetSize());
+        return buffer_->items[index];
+    }
+
+    Type& operator[](size_t index) {
+        assert(index < GetSize());
+        return LeakItems()[index];
+    }
+
+    const Type& At(size_t index) const {
+        return GetItems().At(index);
+    }
+
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("");
+        }
+        return LeakItems()[index];
+    }
+
+    size_t GetSize() const noexcept {
+        return GetItems().GetSize();
+    }
+
+    size_t GetCapacity() const noexcept {
+        return GetItems().GetCapacity();
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return LeakItems().EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    void PushBack(const Type& item) {
+        Items& items = MutableItems();
+        const Type* const data = items.begin();
+        items.PushBack(item);
+        ShareIfReallocated(data);
+    }
+
+    void PushBack(Type&& item) {
+        Items& items = MutableItems();
+        const Type* const data = items.begin();
+        items.PushBack(std::move(item));
+        ShareIfReallocated(data);
+    }
+
+    // Позиции pos — индексы: итераторы разделённого буфера становятся недействительными при Detach
+    Iterator Insert(size_t pos, const Type& value) {
+        assert(pos <= GetSize());
+        Items& items = LeakItems();
+        return items.Insert(items.begin() + pos, value);
+    }
+
+    Iterator Insert(size_t pos, Type&& value) {
+        assert(pos <= GetSize());
+        Items& items = LeakItems();
+        return items.Insert(items.begin() + pos, std::move(value));
+    }
+
+    void PopBack() {
+        assert(!IsEmpty());
+        MutableItems().PopBack();
+    }
+
+    Iterator Erase(size_t pos) {
+        assert(pos < GetSize());
+        Items& items = LeakItems();
+        return items.Erase(items.begin() + pos);
+    }
+
+    Iterator Erase(size_t first, size_t last) {
+        assert(first <= last && last <= GetSize());
+        Items& items = LeakItems();
+        return items.Erase(items.begin() + first, items.begin() + last);
+    }
+
+    void Resize(size_t new_size) {
+        Items& items = MutableItems();
+        const Type* const data = items.begin();
+        items.Resize(new_size);
+        ShareIfReallocated(data);
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Items& items = MutableItems();
+            const Type* const data = items.begin();
+            items.Reserve(new_capacity);
+            ShareIfReallocated(data);
+        }
+    }
+
+    void ShrinkToFit() {
+        if (GetCapacity() > GetSize()) {
+            Items& items = MutableItems();
+            const Type* const data = items.begin();
+            items.ShrinkToFit();
+            ShareIfReallocated(data);
+        }
+    }
+
+    // Разделённый буфер не клонируется, а просто отпускается
+    void Clear() noexcept {
+        if (IsShared()) {
+            Release();
+            buffer_ = nullptr;
+        } else if (buffer_ != nullptr) {
+            buffer_->items.Clear();
+            buffer_->shareable = true;
+        }
+    }
+
+    void swap(CowSimpleVector& other) noexcept {
+        std::swap(buffer_, other.buffer_);
+    }
+
+    Iterator begin() {
+        return IsEmpty() ? nullptr : LeakItems().begin();
+    }
+
+    Iterator end() {
+        return IsEmpty() ? nullptr : LeakItems().end();
+    }
+
+    ConstIterator begin() const noexcept {
+        return GetItems().begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return GetItems().end();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    struct Buffer {
+        template <typename... Args>
+        explicit Buffer(Args&&... args)
+            : items(std::forward<Args>(args)...) {
+        }
+
+        std::atomic<size_t> refs{1};
+        // Сбрасывается, когда владелец выдаёт изменяемую ссылку. Неразделяемый буфер
+        // принадлежит одному вектору, поэтому флаг не нужно делать атомарным
+        bool shareable = true;
+        Items items;
+    };
+
+    static const Items& EmptyItems() noexcept {
+        static const Items empty;
+        return empty;
+    }
+
+    // Собственный буфер для изменения: создаёт пустой или клонирует разделённый
+    Items& MutableItems() {
+        if (buffer_ == nullptr) {
+            buffer_ = new Buffer();
+        } else {
+            Detach();
+        }
+        return buffer_->items;
+    }
+
+    // Собственный буфер, на элементы которого выдаются изменяемые ссылки или итераторы:
+    // пока они могут действовать, буфер не разделяется с копиями
+    Items& LeakItems() {
+        Items& items = MutableItems();
+        buffer_->shareable = false;
+        return items;
+    }
+
+    // Если элементы переехали, выданные ранее ссылки недействительны и буфер снова можно
+    // разделять. Расширение блока на месте (reallocate) ссылки сохраняет
+    void ShareIfReallocated(const Type* old_data) noexcept {
+        if (buffer_->items.begin() != old_data) {
+            buffer_->shareable = true;
+        }
+    }
+
+    // Отпускает ссылку на буфер; последняя ссылка удаляет его.
+    // acq_rel: удаляющий поток видит все изменения, сделанные до отпускания другими
+    void Release() noexcept {
+        if (buffer_ != nullptr && buffer_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete buffer_;
+        }
+    }
+
+    Buffer* buffer_ = nullptr;
+};
+
+template <typename Type, typename Allocator>
+inline bool operator==(const CowSimpleVector<Type, Allocator>& lhs, const CowSimpleVector<Type, Allocator>& rhs) {
+    return lhs.GetItems() == rhs.GetItems();  // может бросить исключение
+}
+
+template <typename Type, typename Allocator>
+inline bool operator!=(const CowSimpleVector<Type, Allocator>& lhs, const CowSimpleVector<Type, Allocator>& rhs) {
+    return !(lhs == rhs);  // может бросить исключение
+}
+
+template <typename Type, typename Allocator>
+inline bool operator<(const CowSimpleVector<Type, Allocator>& lhs, const CowSimpleVector<Type, Allocator>& rhs) {
+    return lhs.GetItems() < rhs.GetItems();  // может бросить исключение
+}
+
+template <typename Type, typename Allocator>
+inline bool operator<=(const CowSimpleVector<Type, Allocator>& lhs, const CowSimpleVector<Type, Allocator>& rhs) {
+    return !(rhs < lhs);  // может бросить исключение
+}
+
+template <typename Type, typename Allocator>
+inline bool operator>(const CowSimpleVector<Type, Allocator>& lhs, const CowSimpleVector<Type, Allocator>& rhs) {
+    return rhs < lhs;  // может бросить исключение
+}
+
+template <typename Type, typename Allocator>
+inline bool operator>=(const CowSimpleVector<Type, Allocator>& lhs, const CowSimpleVector<Type, Allocator>& rhs) {
+    return rhs <= lhs;  // может бросить исключение
+}
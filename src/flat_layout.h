@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "aligned_allocator.h"
+#include "simd_compare.h"
+#include "simple_vector.h"
+
+
+// Раскладки поиска для FlatSet и FlatMap. Ключи всегда хранятся отсортированным
+// SimpleVector; раскладка строит по ним вспомогательный индекс, который находит
+// позицию lower_bound в отсортированном массиве с меньшим числом промахов кэша.
+// Раскладка — тип с вложенным шаблоном Index<Key, Compare>, у которого есть
+//     void Build(const Key* keys, size_t size);
+//     size_t LowerBound(const Key* keys, size_t size, const Key& key, const Compare& less) const;
+// Индекс перестраивается за O(size) после каждого изменения набора ключей
+
+namespace flat_layout_detail {
+
+inline size_t FloorLog2(uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - static_cast<size_t>(__builtin_clzll(value));
+#else
+    size_t result = 0;
+    while (value >>= 1) {
+        ++result;
+    }
+    return result;
+#endif
+}
+
+inline size_t CountTrailingOnes(uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return ~value == 0 ? 64 : static_cast<size_t>(__builtin_ctzll(~value));
+#else
+    size_t result = 0;
+    while (value & 1) {
+        value >>= 1;
+        ++result;
+    }
+    return result;
+#endif
+}
+
+inline void Prefetch([[maybe_unused]] const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#endif
+}
+
+// Число единиц в четырёхбитной маске _mm_movemask_ps
+inline size_t CountMaskBits(int mask) noexcept {
+    return (0x4332322132212110ULL >> (mask * 4)) & 0xF;
+}
+
+// Сколько из count отсортированных ключей node меньше key — позиция lower_bound в узле.
+// Сравнения без ветвлений; для int32_t и float с std::less — по четыре ключа командами SSE2
+template <typename Key, typename Compare>
+size_t CountLess(const Key* node, size_t count, const Key& key, const Compare& less) noexcept {
+    size_t result = 0;
+    size_t i = 0;
+#ifdef SIMPLE_VECTOR_SIMD_SSE2
+    if constexpr (std::is_same_v<Compare, std::less<Key>> && std::is_same_v<Key, int32_t>) {
+        const __m128i needle = _mm_set1_epi32(key);
+        for (; i + 4 <= count; i += 4) {
+            const __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(node + i));
+            const int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(keys, needle)));
+            result += CountMaskBits(mask);
+        }
+    } else if constexpr (std::is_same_v<Compare, std::less<Key>> && std::is_same_v<Key, float>) {
+        const __m128 needle = _mm_set1_ps(key);
+        for (; i + 4 <= count; i += 4) {
+            const int mask = _mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(node + i), needle));
+            result += CountMaskBits(mask);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        result += less(node[i], key) ? 1 : 0;
+    }
+    return result;
+}
+
+// Отменяет слияние InsertBatch: элементы merged, кроме стоящих на позициях fresh
+// (возрастающих позициях новых элементов пачки), по порядку перемещаются обратно в existing
+template <typename Type>
+void MoveBackExisting(SimpleVector<Type>& merged, const SimpleVector<size_t>& fresh, Type* existing) {
+    const size_t* next_fresh = fresh.begin();
+    for (size_t i = 0; i < merged.GetSize(); ++i) {
+        if (next_fresh != fresh.end() && *next_fresh == i) {
+            ++next_fresh;
+        } else {
+            *existing++ = std::move(merged[i]);
+        }
+    }
+}
+
+}  // namespace flat_layout_detail
+
+// Обычный двоичный поиск по отсортированному массиву: без дополнительной памяти,
+// но на больших массивах почти каждая проба — промах кэша
+struct SortedLayout {
+    template <typename Key, typename Compare>
+    class Index {
+    public:
+        void Build(const Key* /*keys*/, size_t /*size*/) noexcept {
+        }
+
+        size_t LowerBound(const Key* keys, size_t size, const Key& key, const Compare& less) const {
+            return static_cast<size_t>(std::lower_bound(keys, keys + size, key, less) - keys);
+        }
+
+        size_t GetMemory() const noexcept {
+            return 0;
+        }
+    };
+};
+
+// Раскладка Эйтцингера: копия ключей в порядке обхода дерева поиска в ширину
+// (корень в ячейке 1, потомки ячейки k — в 2k и 2k + 1). Первые уровни дерева всегда
+// в кэше, а потомков на несколько уровней вперёд можно запросить заранее одной
+// предвыборкой строки кэша. Номер в отсортированном массиве вычисляется по номеру ячейки без таблиц
+struct EytzingerLayout {
+    template <typename Key, typename Compare>
+    class Index {
+        // Столько ключей помещается в строку кэша: потомки ячейки k через log2(BLOCK) уровней
+        // лежат подряд начиная с k * BLOCK
+        static constexpr size_t BLOCK = std::max<size_t>(1, 64 / sizeof(Key));
+
+    public:
+        void Build(const Key* keys, size_t size) {
+            tree_.Clear();
+            if (size == 0) {
+                return;
+            }
+            tree_.Reserve(size + 1);
+            tree_.PushBack(keys[0]);  // ячейка 0 не используется
+            for (size_t k = 1; k <= size; ++k) {
+                tree_.PushBack(keys[Rank(k, size)]);
+            }
+        }
+
+        size_t LowerBound(const Key* /*keys*/, size_t size, const Key& key, const Compare& less) const {
+            const Key* tree = tree_.begin();
+            size_t k = 1;
+            while (k <= size) {
+                flat_layout_detail::Prefetch(tree + std::min(k * BLOCK, size));
+                k = 2 * k + (less(tree[k], key) ? 1 : 0);
+            }
+            // Путь от корня — двоичная запись k; последний поворот налево указывает на ответ
+            k >>= flat_layout_detail::CountTrailingOnes(k) + 1;
+            return k == 0 ? size : Rank(k, size);
+        }
+
+        size_t GetMemory() const noexcept {
+            return tree_.GetCapacity() * sizeof(Key);
+        }
+
+    private:
+        // Номер ячейки k в отсортированном порядке для дерева из size ячеек.
+        // В совершенном дереве высоты height ячейка k на глубине depth стоит на месте
+        // (2 * (k - 2^depth) + 1) * 2^(height - 1 - depth) - 1, а листья последнего уровня —
+        // на чётных местах. Вычитаются отсутствующие листья, стоящие раньше
+        static size_t Rank(size_t k, size_t size) noexcept {
+            const size_t height = flat_layout_detail::FloorLog2(size) + 1;
+            const size_t depth = flat_layout_detail::FloorLog2(k);
+            const size_t perfect = ((2 * (k - (size_t{1} << depth)) + 1) << (height - 1 - depth)) - 1;
+            const size_t leaves = size - ((size_t{1} << (height - 1)) - 1);
+            const size_t leaves_before = (perfect + 1) / 2;
+            return perfect - (leaves_before > leaves ? leaves_before - leaves : 0);
+        }
+
+        SimpleVector<Key, AlignedAllocator<Key, std::max<size_t>(64, alignof(Key))>> tree_;
+    };
+};
+
+// Статическое B+-дерево поверх отсортированного массива. Листья — сам массив, разбитый
+// на узлы по NodeBytes байт (строка кэша); каждый верхний уровень хранит наибольший ключ
+// каждого узла уровня ниже. Поиск спускается от корня, и в каждом узле позиция находится
+// подсчётом меньших ключей без ветвлений (SSE2 для int32_t и float), так что на уровень
+// приходится одна строка кэша вместо нескольких проб двоичного поиска
+template <size_t NodeBytes = 64>
+struct BTreeLayout {
+    template <typename Key, typename Compare>
+    class Index {
+        static constexpr size_t NODE_SIZE = std::max<size_t>(2, NodeBytes / sizeof(Key));
+        using Level = SimpleVector<Key, AlignedAllocator<Key, std::max<size_t>(64, alignof(Key))>>;
+
+    public:
+        void Build(const Key* keys, size_t size) {
+            levels_.Clear();
+            const Key* below = keys;
+            size_t below_size = size;
+            while (below_size > NODE_SIZE) {
+                const size_t nodes = (below_size + NODE_SIZE - 1) / NODE_SIZE;
+                Level level;
+                level.Reserve(nodes);
+                for (size_t node = 0; node < nodes; ++node) {
+                    level.PushBack(below[std::min((node + 1) * NODE_SIZE, below_size) - 1]);
+                }
+                levels_.PushBack(std::move(level));
+                below = levels_[levels_.GetSize() - 1].begin();
+                below_size = nodes;
+            }
+        }
+
+        size_t LowerBound(const Key* keys, size_t size, const Key& key, const Compare& less) const {
+            // index — номер узла на текущем уровне, затем позиция в уровне
+            size_t index = 0;
+            for (size_t level = levels_.GetSize(); level > 0; --level) {
+                index = LowerBoundInNode(levels_[level - 1].begin(), levels_[level - 1].GetSize(), index, key, less);
+            }
+            return std::min(LowerBoundInNode(keys, size, index, key, less), size);
+        }
+
+        size_t GetMemory() const noexcept {
+            size_t bytes = 0;
+            for (const Level& level : levels_) {
+                bytes += level.GetCapacity() * sizeof(Key);
+            }
+            return bytes;
+        }
+
+    private:
+        static size_t LowerBoundInNode(const Key* level, size_t level_size, size_t node, const Key& key,
+                                       const Compare& less) noexcept {
+            const size_t first = node * NODE_SIZE;
+            if (first >= level_size) {
+                return first;
+            }
+            const size_t count = std::min(NODE_SIZE, level_size - first);
+            return first + flat_layout_detail::CountLess(level + first, count, key, less);
+        }
+
+        // levels_[0] — уровень сразу над листьями, последний — корень
+        SimpleVector<Level> levels_;
+    };
+};
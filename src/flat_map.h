@@ -0,0 +1,284 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "flat_layout.h"
+#include "simple_vector.h"
+#include "simple_vector_view.h"
+
+
+// Словарь на двух параллельных SimpleVector: отсортированных ключей и значений.
+// Ключи лежат отдельно от значений, поэтому поиск читает только ключи; индекс раскладки
+// Layout (SortedLayout, EytzingerLayout, BTreeLayout<>) строится по ним так же, как у FlatSet.
+// Элемент i — пара GetKeys()[i], GetValues()[i]. Одиночные вставки и удаления стоят O(n),
+// много пар лучше добавлять одним InsertBatch. Если перестройка индекса после одиночного
+// изменения бросает исключение, изменение отменяется и словарь остаётся прежним
+template <typename Key, typename Value, typename Compare = std::less<Key>, typename Layout = SortedLayout>
+class FlatMap {
+    using Index = typename Layout::template Index<Key, Compare>;
+
+public:
+    using Item = std::pair<Key, Value>;
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& less)
+        : less_(less) {
+    }
+
+    // Массовое построение: пары сортируются по ключу один раз,
+    // из пар с одинаковым ключом остаётся первая
+    explicit FlatMap(SimpleVector<Item>&& items, const Compare& less = Compare())
+        : less_(less) {
+        std::stable_sort(items.begin(), items.end(), ItemLess());
+        keys_.Reserve(items.GetSize());
+        values_.Reserve(items.GetSize());
+        for (Item& item : items) {
+            if (keys_.IsEmpty() || less_(keys_[keys_.GetSize() - 1], item.first)) {
+                keys_.PushBack(std::move(item.first));
+                values_.PushBack(std::move(item.second));
+            }
+        }
+        index_.Build(keys_.begin(), keys_.GetSize());
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    FlatMap(InputIt first, InputIt last, const Compare& less = Compare())
+        : FlatMap(SimpleVector<Item>(first, last), less) {
+    }
+
+    FlatMap(std::initializer_list<Item> init, const Compare& less = Compare())
+        : FlatMap(init.begin(), init.end(), less) {
+    }
+
+    // Указатель на значение ключа key или nullptr
+    Value* Find(const Key& key) {
+        const size_t pos = FindPosition(key);
+        return pos == keys_.GetSize() ? nullptr : &values_[pos];
+    }
+
+    const Value* Find(const Key& key) const {
+        const size_t pos = FindPosition(key);
+        return pos == keys_.GetSize() ? nullptr : &values_[pos];
+    }
+
+    bool Contains(const Key& key) const {
+        return FindPosition(key) != keys_.GetSize();
+    }
+
+    Value& At(const Key& key) {
+        Value* value = Find(key);
+        if (value == nullptr) {
+            throw std::out_of_range("");
+        }
+        return *value;
+    }
+
+    const Value& At(const Key& key) const {
+        const Value* value = Find(key);
+        if (value == nullptr) {
+            throw std::out_of_range("");
+        }
+        return *value;
+    }
+
+    // Значение ключа key; если ключа нет, добавляет его со значением по умолчанию
+    Value& operator[](const Key& key) {
+        return *Insert(key, Value()).first;
+    }
+
+    // Добавляет пару, если ключа ещё нет. Возвращает указатель на значение ключа и признак добавления
+    std::pair<Value*, bool> Insert(const Key& key, Value value) {
+        const size_t pos = LowerBound(key);
+        if (pos != keys_.GetSize() && !less_(key, keys_[pos])) {
+            return {&values_[pos], false};
+        }
+        keys_.Insert(keys_.begin() + pos, key);
+        try {
+            values_.Insert(values_.begin() + pos, std::move(value));
+        } catch (...) {
+            keys_.Erase(keys_.begin() + pos);
+            throw;
+        }
+        Rebuild([&] {
+            keys_.Erase(keys_.begin() + pos);
+            values_.Erase(values_.begin() + pos);
+        });
+        return {&values_[pos], true};
+    }
+
+    // Добавляет пару или заменяет значение существующего ключа. Возвращает true, если ключ добавлен
+    bool InsertOrAssign(const Key& key, Value value) {
+        auto [existing, inserted] = Insert(key, Value());
+        *existing = std::move(value);
+        return inserted;
+    }
+
+    // Добавляет пары [first, last) с ключами, которых ещё нет; значения имеющихся ключей
+    // не меняются, из повторов внутри пачки остаётся первая пара. Пачка сортируется
+    // и сливается с имеющимися парами за один проход. Возвращает число добавленных пар.
+    // Имеющиеся пары перемещаются в новые буферы, а если исключение бросает сравнение,
+    // выделение памяти или построение индекса, перемещаются обратно и словарь не меняется
+    // (если не бросает перемещение ключей и значений)
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    size_t InsertBatch(InputIt first, InputIt last) {
+        SimpleVector<Item> batch(first, last);
+        std::stable_sort(batch.begin(), batch.end(), ItemLess());
+        SimpleVector<Key> keys;
+        SimpleVector<Value> values;
+        keys.Reserve(keys_.GetSize() + batch.GetSize());
+        values.Reserve(keys_.GetSize() + batch.GetSize());
+        // Позиции новых пар в keys и values: остальные при отмене возвращаются в keys_ и values_
+        SimpleVector<size_t> fresh;
+        fresh.Reserve(batch.GetSize());
+        size_t lhs = 0;
+        const auto take_existing = [&] {
+            keys.PushBack(std::move(keys_[lhs]));
+            values.PushBack(std::move(values_[lhs]));
+            ++lhs;
+        };
+        Index index;
+        try {
+            for (Item& item : batch) {
+                while (lhs != keys_.GetSize() && less_(keys_[lhs], item.first)) {
+                    take_existing();
+                }
+                const bool present = (lhs != keys_.GetSize() && !less_(item.first, keys_[lhs]))
+                                     || (!keys.IsEmpty() && !less_(keys[keys.GetSize() - 1], item.first));
+                if (!present) {
+                    fresh.PushBack(keys.GetSize());
+                    keys.PushBack(std::move(item.first));
+                    values.PushBack(std::move(item.second));
+                }
+            }
+            while (lhs != keys_.GetSize()) {
+                take_existing();
+            }
+            index.Build(keys.begin(), keys.GetSize());
+        } catch (...) {
+            flat_layout_detail::MoveBackExisting(keys, fresh, keys_.begin());
+            flat_layout_detail::MoveBackExisting(values, fresh, values_.begin());
+            throw;
+        }
+        const size_t inserted = keys.GetSize() - keys_.GetSize();
+        keys_.swap(keys);
+        values_.swap(values);
+        index_ = std::move(index);
+        return inserted;
+    }
+
+    // Удаляет пару с ключом key. Возвращает число удалённых пар
+    size_t Erase(const Key& key) {
+        const size_t pos = FindPosition(key);
+        if (pos == keys_.GetSize()) {
+            return 0;
+        }
+        Key removed_key = std::move(keys_[pos]);
+        Value removed_value = std::move(values_[pos]);
+        keys_.Erase(keys_.begin() + pos);
+        values_.Erase(values_.begin() + pos);
+        Rebuild([&] {
+            keys_.Insert(keys_.begin() + pos, std::move(removed_key));
+            values_.Insert(values_.begin() + pos, std::move(removed_value));
+        });
+        return 1;
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+        values_.Clear();
+        index_.Build(keys_.begin(), 0);
+    }
+
+    size_t GetSize() const noexcept {
+        return keys_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return keys_.IsEmpty();
+    }
+
+    // Отсортированные ключи
+    const SimpleVector<Key>& GetKeys() const noexcept {
+        return keys_;
+    }
+
+    // Значения в порядке ключей. Сами значения можно менять, их число — нельзя
+    MutableSimpleVectorView<Value> GetValues() noexcept {
+        return values_;
+    }
+
+    const SimpleVector<Value>& GetValues() const noexcept {
+        return values_;
+    }
+
+    // Память индекса раскладки сверх самих ключей, в байтах
+    size_t GetIndexMemory() const noexcept {
+        return index_.GetMemory();
+    }
+
+    void swap(FlatMap& other) noexcept {
+        using std::swap;
+        swap(less_, other.less_);
+        keys_.swap(other.keys_);
+        values_.swap(other.values_);
+        swap(index_, other.index_);
+    }
+
+private:
+    auto ItemLess() const {
+        return [this](const Item& lhs, const Item& rhs) {
+            return less_(lhs.first, rhs.first);
+        };
+    }
+
+    size_t LowerBound(const Key& key) const {
+        return index_.LowerBound(keys_.begin(), keys_.GetSize(), key, less_);
+    }
+
+    // Позиция ключа key или GetSize(), если его нет
+    size_t FindPosition(const Key& key) const {
+        const size_t pos = LowerBound(key);
+        return pos != keys_.GetSize() && !less_(key, keys_[pos]) ? pos : keys_.GetSize();
+    }
+
+    // Перестраивает индекс после одиночного изменения пар (см. FlatSet::Rebuild):
+    // при исключении старый индекс остаётся, undo возвращает пары, а если бросает
+    // и отмена — словарь очищается
+    template <typename Undo>
+    void Rebuild(Undo undo) {
+        Index index;
+        try {
+            index.Build(keys_.begin(), keys_.GetSize());
+        } catch (...) {
+            try {
+                undo();
+            } catch (...) {
+                Clear();
+            }
+            throw;
+        }
+        index_ = std::move(index);
+    }
+
+    [[no_unique_address]] Compare less_{};
+    SimpleVector<Key> keys_;
+    SimpleVector<Value> values_;
+    Index index_;
+};
+
+template <typename Key, typename Value, typename Compare, typename Layout>
+inline bool operator==(const FlatMap<Key, Value, Compare, Layout>& lhs, const FlatMap<Key, Value, Compare, Layout>& rhs) {
+    return lhs.GetKeys() == rhs.GetKeys() && lhs.GetValues() == rhs.GetValues();  // может бросить исключение
+}
+
+template <typename Key, typename Value, typename Compare, typename Layout>
+inline bool operator!=(const FlatMap<Key, Value, Compare, Layout>& lhs, const FlatMap<Key, Value, Compare, Layout>& rhs) {
+    return !(lhs == rhs);  // может бросить исключение
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "flat_layout.h"
+#include "simple_vector.h"
+
+
+// Множество на отсортированном SimpleVector для таблиц, которые строятся один раз
+// или пачками и затем много читаются. Поиск идёт через индекс раскладки Layout
+// (SortedLayout, EytzingerLayout, BTreeLayout<>), итерация — по отсортированным ключам.
+// Одиночные Insert и Erase стоят O(n), поэтому добавлять много ключей лучше
+// одним InsertBatch: новые ключи сортируются и сливаются с имеющимися за один проход.
+// Если перестройка индекса после одиночного изменения бросает исключение, изменение
+// отменяется и множество остаётся прежним
+template <typename Key, typename Compare = std::less<Key>, typename Layout = SortedLayout>
+class FlatSet {
+    using Index = typename Layout::template Index<Key, Compare>;
+
+public:
+    using ConstIterator = const Key*;
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& less)
+        : less_(less) {
+    }
+
+    // Массовое построение: ключи сортируются и очищаются от повторов один раз
+    explicit FlatSet(SimpleVector<Key>&& keys, const Compare& less = Compare())
+        : less_(less),
+          keys_(std::move(keys)) {
+        std::sort(keys_.begin(), keys_.end(), less_);
+        keys_.Erase(std::unique(keys_.begin(), keys_.end(), Equivalent()), keys_.end());
+        index_.Build(keys_.begin(), keys_.GetSize());
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    FlatSet(InputIt first, InputIt last, const Compare& less = Compare())
+        : FlatSet(SimpleVector<Key>(first, last), less) {
+    }
+
+    FlatSet(std::initializer_list<Key> init, const Compare& less = Compare())
+        : FlatSet(init.begin(), init.end(), less) {
+    }
+
+    // Итератор на ключ, эквивалентный key, или end()
+    ConstIterator Find(const Key& key) const {
+        const ConstIterator it = LowerBound(key);
+        return it != end() && !less_(key, *it) ? it : end();
+    }
+
+    bool Contains(const Key& key) const {
+        return Find(key) != end();
+    }
+
+    size_t Count(const Key& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    // Первый ключ, не меньший key
+    ConstIterator LowerBound(const Key& key) const {
+        return begin() + index_.LowerBound(keys_.begin(), keys_.GetSize(), key, less_);
+    }
+
+    // Добавляет ключ, если его нет. Возвращает итератор на ключ и признак добавления
+    std::pair<ConstIterator, bool> Insert(const Key& key) {
+        const size_t pos = static_cast<size_t>(LowerBound(key) - begin());
+        if (pos != keys_.GetSize() && !less_(key, keys_[pos])) {
+            return {begin() + pos, false};
+        }
+        keys_.Insert(keys_.begin() + pos, key);
+        Rebuild([&] {
+            keys_.Erase(keys_.begin() + pos);
+        });
+        return {begin() + pos, true};
+    }
+
+    // Добавляет ключи [first, last), которых ещё нет: сортирует их и сливает с имеющимися
+    // за один проход в новый буфер. Возвращает число добавленных ключей.
+    // Имеющиеся ключи перемещаются в новый буфер, а если исключение бросает сравнение,
+    // выделение памяти или построение индекса, перемещаются обратно и множество не меняется
+    // (если не бросает перемещение ключей)
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    size_t InsertBatch(InputIt first, InputIt last) {
+        SimpleVector<Key> batch(first, last);
+        std::sort(batch.begin(), batch.end(), less_);
+        SimpleVector<Key> merged;
+        merged.Reserve(keys_.GetSize() + batch.GetSize());
+        // Позиции новых ключей в merged: остальные при отмене возвращаются в keys_
+        SimpleVector<size_t> fresh;
+        fresh.Reserve(batch.GetSize());
+        Key* lhs = keys_.begin();
+        Key* const lhs_end = keys_.end();
+        Index index;
+        try {
+            for (Key* rhs = batch.begin(); rhs != batch.end(); ++rhs) {
+                while (lhs != lhs_end && less_(*lhs, *rhs)) {
+                    merged.PushBack(std::move(*lhs++));
+                }
+                const bool present = (lhs != lhs_end && !less_(*rhs, *lhs))
+                                     || (!merged.IsEmpty() && !less_(merged[merged.GetSize() - 1], *rhs));
+                if (!present) {
+                    fresh.PushBack(merged.GetSize());
+                    merged.PushBack(std::move(*rhs));
+                }
+            }
+            while (lhs != lhs_end) {
+                merged.PushBack(std::move(*lhs++));
+            }
+            index.Build(merged.begin(), merged.GetSize());
+        } catch (...) {
+            flat_layout_detail::MoveBackExisting(merged, fresh, keys_.begin());
+            throw;
+        }
+        const size_t inserted = merged.GetSize() - keys_.GetSize();
+        keys_.swap(merged);
+        index_ = std::move(index);
+        return inserted;
+    }
+
+    // Удаляет ключ, эквивалентный key. Возвращает число удалённых ключей
+    size_t Erase(const Key& key) {
+        const ConstIterator it = Find(key);
+        if (it == end()) {
+            return 0;
+        }
+        const size_t pos = static_cast<size_t>(it - begin());
+        Key removed = std::move(keys_[pos]);
+        keys_.Erase(keys_.begin() + pos);
+        Rebuild([&] {
+            keys_.Insert(keys_.begin() + pos, std::move(removed));
+        });
+        return 1;
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+        index_.Build(keys_.begin(), 0);
+    }
+
+    size_t GetSize() const noexcept {
+        return keys_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return keys_.IsEmpty();
+    }
+
+    // Отсортированные ключи
+    const SimpleVector<Key>& GetKeys() const noexcept {
+        return keys_;
+    }
+
+    // Память индекса раскладки сверх самих ключей, в байтах
+    size_t GetIndexMemory() const noexcept {
+        return index_.GetMemory();
+    }
+
+    ConstIterator begin() const noexcept {
+        return keys_.begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return keys_.end();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    void swap(FlatSet& other) noexcept {
+        using std::swap;
+        swap(less_, other.less_);
+        keys_.swap(other.keys_);
+        swap(index_, other.index_);
+    }
+
+private:
+    auto Equivalent() const {
+        return [this](const Key& lhs, const Key& rhs) {
+            return !less_(lhs, rhs) && !less_(rhs, lhs);
+        };
+    }
+
+    // Перестраивает индекс после одиночного изменения ключей. Новый индекс строится отдельно,
+    // поэтому при исключении старый остаётся целым, а undo возвращает ключи к нему.
+    // Если бросает и сама отмена, множество очищается, чтобы индекс не разошёлся с ключами
+    template <typename Undo>
+    void Rebuild(Undo undo) {
+        Index index;
+        try {
+            index.Build(keys_.begin(), keys_.GetSize());
+        } catch (...) {
+            try {
+                undo();
+            } catch (...) {
+                Clear();
+            }
+            throw;
+        }
+        index_ = std::move(index);
+    }
+
+    [[no_unique_address]] Compare less_{};
+    SimpleVector<Key> keys_;
+    Index index_;
+};
+
+template <typename Key, typename Compare, typename Layout>
+inline bool operator==(const FlatSet<Key, Compare, Layout>& lhs, const FlatSet<Key, Compare, Layout>& rhs) {
+    return lhs.GetKeys() == rhs.GetKeys();  // может бросить исключение
+}
+
+template <typename Key, typename Compare, typename Layout>
+inline bool operator!=(const FlatSet<Key, Compare, Layout>& lhs, const FlatSet<Key, Compare, Layout>& rhs) {
+    return !(lhs == rhs);  // может бросить исключение
+}
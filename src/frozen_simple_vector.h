@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include "simple_vector.h"
+
+
+// Замораживает вектор, построенный на этапе компиляции, в статический массив.
+// Builder — функция или лямбда без захвата, которая строит и возвращает SimpleVector
+// (PushBack, Insert, сортировка — всё, что допускает constexpr). Память, выделенная при
+// компиляции, не может дожить до выполнения программы, поэтому содержимое копируется
+// в std::array; размер массива узнаётся отдельным вызовом Builder. Результат, записанный
+// в constexpr-переменную, лежит в .rodata и не стоит ничего при запуске:
+//     constexpr auto SQUARES = FreezeSimpleVector<[] {
+//         SimpleVector<int> squares;
+//         for (int i = 0; i < 10; ++i) {
+//             squares.PushBack(i * i);
+//         }
+//         return squares;
+//     }>();
+// Элементы должны быть конструируемыми по умолчанию и копируемыми на этапе компиляции
+template <auto Builder>
+consteval auto FreezeSimpleVector() {
+    using Vector = decltype(Builder());
+    using Type = std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<const Vector&>().begin())>>;
+    constexpr size_t SIZE = Builder().GetSize();
+    const Vector items = Builder();
+    std::array<Type, SIZE> frozen{};
+    for (size_t i = 0; i < SIZE; ++i) {
+        frozen[i] = items[i];
+    }
+    return frozen;
+}
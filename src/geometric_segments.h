@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+
+// Разбиение индексов на сегменты, размеры которых растут степенями двойки:
+// сегмент k содержит (1 << FirstBits) << k элементов. Первые n элементов занимают
+// O(log n) сегментов, а номер сегмента и смещение в нём вычисляются без циклов
+template <size_t FirstBits>
+struct GeometricSegments {
+    static constexpr size_t FIRST_SIZE = size_t{1} << FirstBits;
+    // Сегментов достаточно для любого индекса size_t
+    static constexpr size_t MAX_COUNT = 64 - FirstBits;
+
+    static constexpr size_t SegmentSize(size_t segment) noexcept {
+        return FIRST_SIZE << segment;
+    }
+
+    // Номер сегмента и смещение в нём для элемента index
+    static std::pair<size_t, size_t> Locate(size_t index) noexcept {
+        const uint64_t shifted = static_cast<uint64_t>(index) + FIRST_SIZE;
+        const size_t log = FloorLog2(shifted);
+        return {log - FirstBits, static_cast<size_t>(shifted - (uint64_t{1} << log))};
+    }
+
+    // Сколько элементов помещается в первые count сегментов
+    static constexpr size_t Capacity(size_t count) noexcept {
+        return count == 0 ? 0 : (FIRST_SIZE << count) - FIRST_SIZE;
+    }
+
+    static size_t FloorLog2(uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - static_cast<size_t>(__builtin_clzll(value));
+#else
+        size_t result = 0;
+        while (value >>= 1) {
+            ++result;
+        }
+        return result;
+#endif
+    }
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+
+// Политики роста вместимости SimpleVector. Политика — тип со статическим методом
+//     static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size);
+// который по текущей вместимости и требуемому числу элементов (required > capacity)
+// возвращает новую вместимость, не меньшую required
+
+// Рост вдвое (поведение по умолчанию): амортизированно O(1) на вставку
+struct DoublingGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        return std::max(capacity * 2, required);
+    }
+};
+
+// Рост в полтора раза: меньше неиспользуемого хвоста и лучше переиспользуется
+// освобождённая память, ценой более частых перевыделений
+struct OneAndHalfGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        return std::max(capacity + capacity / 2, required);
+    }
+};
+
+// Ровно столько, сколько требуется. Подходит для векторов, размер которых известен
+// заранее; при поэлементном добавлении каждая вставка перевыделяет память
+struct ExactGrowth {
+    static constexpr size_t NextCapacity(size_t /*capacity*/, size_t required, size_t /*element_size*/) noexcept {
+        return required;
+    }
+};
+
+// Округляет размер блока в байтах до размера, который malloc фактически выделит
+// под такой запрос, чтобы вектор мог пользоваться всей полученной памятью
+constexpr size_t MallocSizeClass(size_t bytes) noexcept {
+#if defined(__GLIBC__)
+    // glibc: блоки выровнены на 16 байт, 8 байт занимает заголовок, минимальный блок — 32 байта.
+    // Крупные запросы (порог mmap по умолчанию — 128 КБ) выделяются целыми страницами
+    constexpr size_t MMAP_THRESHOLD = 128 * 1024;
+    constexpr size_t PAGE_SIZE = 4096;
+    if (bytes >= MMAP_THRESHOLD) {
+        return (bytes + 16 + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE - 16;
+    }
+    return std::max<size_t>(24, (bytes + 8 + 15) / 16 * 16 - 8);
+#else
+    // jemalloc/tcmalloc-подобные классы: кратность 16 для малых размеров,
+    // далее по четыре класса на каждую степень двойки
+    if (bytes <= 128) {
+        return std::max<size_t>(16, (bytes + 15) / 16 * 16);
+    }
+    size_t group = 128;
+    while (group * 2 < bytes) {
+        group *= 2;
+    }
+    const size_t step = group / 4;
+    return (bytes + step - 1) / step * step;
+#endif
+}
+
+// Растёт по политике Base, а затем добирает вместимость до размерного класса malloc
+template <typename Base = DoublingGrowth>
+struct MallocSizeClassGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t elements = Base::NextCapacity(capacity, required, element_size);
+        return std::max(elements, MallocSizeClass(elements * element_size) / element_size);
+    }
+};
+
+// Растёт по политике Base, а затем добирает вместимость до кратного Alignment байт.
+// С AlignedAllocator вектор пользуется всем выделенным блоком, а вместимость кратна
+// числу элементов в векторном регистре ширины Alignment
+template <size_t Alignment, typename Base = DoublingGrowth>
+struct PaddedGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t elements = Base::NextCapacity(capacity, required, element_size);
+        const size_t bytes = (elements * element_size + Alignment - 1) / Alignment * Alignment;
+        return std::max(elements, bytes / element_size);
+    }
+};
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#include "allocator.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+
+// Аллокатор для очень больших векторов. Блоки от ThresholdBytes байт берутся прямо у ядра
+// анонимным mmap с MADV_HUGEPAGE (прозрачные страницы по 2 МБ — меньше промахов TLB),
+// выровненным по 2 МБ, и растут через mremap: ядро переставляет страницы, а не копирует элементы.
+// Блоки меньше порога выделяет MallocAllocator. Перенос без копирования работает для
+// тривиально перемещаемых типов — только для них ArrayPtr вызывает reallocate.
+// Вне Linux аллокатор ведёт себя как MallocAllocator
+//     SimpleVector<uint64_t, HugePageAllocator<uint64_t>> ids;
+template <typename Type, size_t ThresholdBytes = (size_t{2} << 20)>
+class HugePageAllocator {
+public:
+    using value_type = Type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    // Нетиповой параметр шаблона не даёт allocator_traits вывести rebind самостоятельно
+    template <typename Other>
+    struct rebind {
+        using other = HugePageAllocator<Other, ThresholdBytes>;
+    };
+
+    static constexpr size_t HUGE_PAGE_SIZE = size_t{2} << 20;
+
+    HugePageAllocator() noexcept = default;
+
+    template <typename Other>
+    HugePageAllocator(const HugePageAllocator<Other, ThresholdBytes>&) noexcept {
+    }
+
+    // Наибольшее число элементов, размер отображения под которые (с округлением
+    // до большой страницы) ещё представим в size_t
+    constexpr size_t max_size() const noexcept {
+        return (std::numeric_limits<size_t>::max() - (HUGE_PAGE_SIZE - 1)) / sizeof(Type);
+    }
+
+    // Выбрасывает std::bad_array_new_length, если size > max_size()
+    [[nodiscard]] Type* allocate(size_t size) {
+        if (size > max_size()) {
+            throw std::bad_array_new_length();
+        }
+        if (!IsMapped(size)) {
+            return MallocAllocator<Type>().allocate(size);
+        }
+        return Map(size);
+    }
+
+    void deallocate(Type* ptr, size_t size) noexcept {
+        if (!IsMapped(size)) {
+            MallocAllocator<Type>().deallocate(ptr, size);
+            return;
+        }
+        Unmap(ptr, size);
+    }
+
+    // Переносит блок из old_size элементов в блок из new_size элементов (см. MallocAllocator::reallocate).
+    // Отображённый блок растёт и сжимается через mremap, а если за ним нет места, его страницы
+    // переносятся на новое выровненное место без копирования; при переходе через порог
+    // содержимое копируется между кучей и отображённой памятью
+    [[nodiscard]] Type* reallocate(Type* ptr, size_t old_size, size_t new_size) {
+        if (new_size > max_size()) {
+            throw std::bad_array_new_length();
+        }
+        const bool old_mapped = ptr != nullptr && IsMapped(old_size);
+        const bool new_mapped = IsMapped(new_size);
+        if (!old_mapped && !new_mapped) {
+            return MallocAllocator<Type>().reallocate(ptr, old_size, new_size);
+        }
+#if defined(__linux__)
+        if (old_mapped && new_mapped) {
+            const size_t old_bytes = MappedBytes(old_size);
+            const size_t new_bytes = MappedBytes(new_size);
+            // На месте: сжатие удаётся всегда, рост — если адреса за блоком свободны
+            void* new_ptr = mremap(static_cast<void*>(ptr), old_bytes, new_bytes, 0);
+            if (new_ptr == MAP_FAILED) {
+                // MREMAP_MAYMOVE выбрал бы адрес, выровненный лишь по 4 КБ,
+                // поэтому страницы переносятся поверх выровненного отображения от Map
+                Type* target = Map(new_size);
+                new_ptr = mremap(static_cast<void*>(ptr), old_bytes, new_bytes, MREMAP_MAYMOVE | MREMAP_FIXED,
+                                 static_cast<void*>(target));
+                if (new_ptr == MAP_FAILED) {
+                    Unmap(target, new_size);
+                    throw std::bad_alloc();
+                }
+            }
+            madvise(new_ptr, new_bytes, MADV_HUGEPAGE);
+            return static_cast<Type*>(new_ptr);
+        }
+#endif
+        Type* new_ptr = allocate(new_size);
+        if (ptr != nullptr) {
+            std::memcpy(static_cast<void*>(new_ptr), static_cast<const void*>(ptr),
+                        std::min(old_size, new_size) * sizeof(Type));
+            deallocate(ptr, old_size);
+        }
+        return new_ptr;
+    }
+
+    // Сколько байт занимает отображение под size элементов: размер округляется до большой страницы
+    static size_t MappedBytes(size_t size) noexcept {
+        return (size * sizeof(Type) + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    }
+
+    // Берётся ли блок из size элементов у ядра, а не у malloc
+    static bool IsMapped(size_t size) noexcept {
+#if defined(__linux__)
+        return size * sizeof(Type) >= ThresholdBytes && alignof(Type) <= HUGE_PAGE_SIZE;
+#else
+        (void)size;
+        return false;
+#endif
+    }
+
+private:
+    // mmap выравнивает лишь по обычной странице, а ядро отдаёт большие страницы только
+    // выровненным по 2 МБ участкам. Поэтому отображается на большую страницу больше,
+    // и невыровненные начало и хвост сразу возвращаются ядру
+    static Type* Map([[maybe_unused]] size_t size) {
+#if defined(__linux__)
+        const size_t bytes = MappedBytes(size);
+        if (bytes > std::numeric_limits<size_t>::max() - HUGE_PAGE_SIZE) {
+            throw std::bad_alloc();
+        }
+        const size_t reserved = bytes + HUGE_PAGE_SIZE;
+        void* raw = mmap(nullptr, reserved, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        const uintptr_t first = reinterpret_cast<uintptr_t>(raw);
+        const uintptr_t aligned = (first + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        const size_t head = aligned - first;
+        if (head != 0) {
+            munmap(raw, head);
+        }
+        if (reserved - head != bytes) {
+            munmap(reinterpret_cast<void*>(aligned + bytes), reserved - head - bytes);
+        }
+        void* ptr = reinterpret_cast<void*>(aligned);
+        // Совет ядру: если прозрачные большие страницы отключены, вызов ничего не меняет
+        madvise(ptr, bytes, MADV_HUGEPAGE);
+        return static_cast<Type*>(ptr);
+#else
+        throw std::bad_alloc();
+#endif
+    }
+
+    static void Unmap([[maybe_unused]] Type* ptr, [[maybe_unused]] size_t size) noexcept {
+#if defined(__linux__)
+        munmap(static_cast<void*>(ptr), MappedBytes(size));
+#endif
+    }
+};
+
+template <typename Lhs, typename Rhs, size_t ThresholdBytes>
+inline bool operator==(const HugePageAllocator<Lhs, ThresholdBytes>&, const HugePageAllocator<Rhs, ThresholdBytes>&) noexcept {
+    return true;
+}
+
+template <typename Lhs, typename Rhs, size_t ThresholdBytes>
+inline bool operator!=(const HugePageAllocator<Lhs, ThresholdBytes>&, const HugePageAllocator<Rhs, ThresholdBytes>&) noexcept {
+    return false;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+
+// Итератор произвольного доступа для контейнеров, элементы которых лежат не одним
+// массивом (сегментами, корзинами), но доступны по индексу через operator[].
+// Хранит указатель на контейнер и индекс, поэтому остаётся действительным при росте контейнера
+template <typename Container, typename Value>
+class IndexIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+
+    IndexIterator() noexcept = default;
+
+    IndexIterator(Container* container, size_t index) noexcept
+        : container_(container),
+          index_(index) {
+    }
+
+    // Неконстантный итератор преобразуется в константный
+    template <typename OtherContainer, typename OtherValue,
+              typename = std::enable_if_t<std::is_convertible_v<OtherContainer*, Container*>
+                                          && std::is_convertible_v<OtherValue*, Value*>>>
+    IndexIterator(const IndexIterator<OtherContainer, OtherValue>& other) noexcept
+        : container_(other.GetContainer()),
+          index_(other.GetIndex()) {
+    }
+
+    Container* GetContainer() const noexcept {
+        return container_;
+    }
+
+    size_t GetIndex() const noexcept {
+        return index_;
+    }
+
+    reference operator*() const {
+        return (*container_)[index_];
+    }
+
+    pointer operator->() const {
+        return &(*container_)[index_];
+    }
+
+    reference operator[](difference_type offset) const {
+        return (*container_)[index_ + offset];
+    }
+
+    IndexIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    IndexIterator operator++(int) noexcept {
+        IndexIterator old = *this;
+        ++index_;
+        return old;
+    }
+
+    IndexIterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+
+    IndexIterator operator--(int) noexcept {
+        IndexIterator old = *this;
+        --index_;
+        return old;
+    }
+
+    IndexIterator& operator+=(difference_type offset) noexcept {
+        index_ += offset;
+        return *this;
+    }
+
+    IndexIterator& operator-=(difference_type offset) noexcept {
+        index_ -= offset;
+        return *this;
+    }
+
+    friend IndexIterator operator+(IndexIterator it, difference_type offset) noexcept {
+        return it += offset;
+    }
+
+    friend IndexIterator operator+(difference_type offset, IndexIterator it) noexcept {
+        return it += offset;
+    }
+
+    friend IndexIterator operator-(IndexIterator it, difference_type offset) noexcept {
+        return it -= offset;
+    }
+
+    friend difference_type operator-(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+
+    friend bool operator<(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+
+    friend bool operator>(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ > rhs.index_;
+    }
+
+    friend bool operator<=(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ <= rhs.index_;
+    }
+
+    friend bool operator>=(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ >= rhs.index_;
+    }
+
+private:
+    Container* container_ = nullptr;
+    size_t index_ = 0;
+};
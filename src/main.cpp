@@ -1,6 +1,28 @@
 #include <iostream>
 
+#include "aligned_allocator.h"
+#include "arena_allocator.h"
+#include "concurrent_simple_vector.h"
+#include "cow_simple_vector.h"
+#include "flat_map.h"
+#include "flat_set.h"
+#include "frozen_simple_vector.h"
+#if defined(__linux__)
+#include "huge_page_allocator.h"
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include "mapped_simple_vector.h"
+#endif
+#include "parallel_algorithms.h"
+#include "segmented_vector.h"
+#include "simple_aligned_vector.h"
+#include "simple_bit_vector.h"
 #include "simple_vector.h"
+#include "simple_vector_io.h"
+#include "simple_vector_view.h"
+#include "small_simple_vector.h"
+#include "soa_vector.h"
+#include "static_vector.h"
 // Tests
 #include "tests.h"
 
@@ -10,6 +32,30 @@ int main() {
     Test2();
     Test3();
     Test4();
+    Test5();
+    Test6();
+    Test7();
+    Test8();
+    Test9();
+    Test10();
+    Test11();
+    Test12();
+    Test13();
+    Test14();
+    Test15();
+    Test16();
+    Test17();
+    Test18();
+    Test19();
+    Test20();
+    Test21();
+    Test22();
+    Test23();
+    Test24();
+    Test25();
+    Test26();
+    Test27();
+    Test28();
     std::cerr << "OK";
     return 0;
 }
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+// Отображение файлов в память есть только в POSIX-системах: в остальных заголовок пуст
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+// Режим открытия файла MappedSimpleVector
+enum class MappedOpenMode {
+    READ_ONLY,   // существующий файл только для чтения
+    READ_WRITE,  // существующий файл для чтения и записи; отсутствующий файл создаётся пустым
+    CREATE,      // новый пустой файл; существующий файл обрезается
+};
+
+// Заголовок файла MappedSimpleVector. Элементы начинаются со смещения DATA_OFFSET,
+// вместимость определяется размером файла
+struct MappedVectorHeader {
+    static constexpr char MAGIC[8] = {'S', 'V', 'E', 'C', 'T', 'O', 'R', '\0'};
+    static constexpr uint32_t VERSION = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t element_size;
+    uint32_t element_alignment;
+    uint32_t reserved;
+    uint64_t size;
+};
+
+// Вектор тривиально копируемых элементов, хранящихся в отображённом в память файле.
+// Открытие существующего файла стоит одного вызова mmap: элементы не читаются и не
+// десериализуются, страницы подгружаются ядром при первом обращении.
+// Заголовок фиксирует размер и выравнивание элемента и версию формата; при открытии
+// файла с другим типом элементов выбрасывается std::runtime_error, ошибки системы — std::system_error.
+// Файл, открытый только для чтения, отображается без права записи: изменяющие методы
+// выбрасывают std::logic_error, а запись через ссылку на элемент завершит процесс.
+// Изменения попадают в файл через общий (MAP_SHARED) кэш страниц; Flush запускает запись
+// на диск, Sync дожидается её. Файлы не переносимы между платформами с разным порядком байт
+template <typename Type>
+class MappedSimpleVector {
+    static_assert(std::is_trivially_copyable_v<Type>, "MappedSimpleVector stores raw bytes of elements");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    // Элементы начинаются с первой кэш-линии после заголовка
+    static constexpr size_t DATA_OFFSET = std::max<size_t>(64, alignof(Type));
+    static_assert(sizeof(MappedVectorHeader) <= DATA_OFFSET);
+
+    MappedSimpleVector(const std::string& path, MappedOpenMode mode = MappedOpenMode::READ_WRITE)
+        : read_only_(mode == MappedOpenMode::READ_ONLY)
+    {
+        int flags = O_RDWR | O_CREAT;
+        if (mode == MappedOpenMode::READ_ONLY) {
+            flags = O_RDONLY;
+        } else if (mode == MappedOpenMode::CREATE) {
+            flags |= O_TRUNC;
+        }
+        fd_ = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        }
+        try {
+            struct stat st;
+            if (::fstat(fd_, &st) != 0) {
+                throw std::system_error(errno, std::generic_category(), "fstat " + path);
+            }
+            size_t file_size = static_cast<size_t>(st.st_size);
+            const bool is_new = file_size == 0 && !read_only_;
+            if (is_new) {
+                file_size = DATA_OFFSET;
+                Truncate(file_size);
+            }
+            if (file_size < DATA_OFFSET) {
+                throw std::runtime_error("MappedSimpleVector: " + path + " is too small");
+            }
+            Map(file_size);
+            if (is_new) {
+                MappedVectorHeader& header = Header();
+                std::memcpy(header.magic, MappedVectorHeader::MAGIC, sizeof(header.magic));
+                header.version = MappedVectorHeader::VERSION;
+                header.element_size = sizeof(Type);
+                header.element_alignment = alignof(Type);
+                header.size = 0;
+            }
+            CheckHeader(path, file_size);
+        } catch (...) {
+            Close();
+            throw;
+        }
+    }
+
+    MappedSimpleVector(const MappedSimpleVector&) = delete;
+    MappedSimpleVector& operator=(const MappedSimpleVector&) = delete;
+
+    MappedSimpleVector(MappedSimpleVector&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1)),
+          mapping_(std::exchange(other.mapping_, nullptr)),
+          mapped_bytes_(std::exchange(other.mapped_bytes_, 0)),
+          read_only_(other.read_only_) {
+    }
+
+    MappedSimpleVector& operator=(MappedSimpleVector&& other) noexcept {
+        if (this != &other) {
+            Close();
+            fd_ = std::exchange(other.fd_, -1);
+            mapping_ = std::exchange(other.mapping_, nullptr);
+            mapped_bytes_ = std::exchange(other.mapped_bytes_, 0);
+            read_only_ = other.read_only_;
+        }
+        return *this;
+    }
+
+    // Закрывает файл без ожидания записи на диск (см. Sync)
+    ~MappedSimpleVector() {
+        Close();
+    }
+
+    Type& operator[](size_t index) noexcept {
+        assert(index < GetSize());
+        return Data()[index];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < GetSize());
+        return Data()[index];
+    }
+
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("");
+        }
+        return Data()[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("");
+        }
+        return Data()[index];
+    }
+
+    size_t GetSize() const noexcept {
+        return mapping_ != nullptr ? static_cast<size_t>(Header().size) : 0;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return mapped_bytes_ > DATA_OFFSET ? (mapped_bytes_ - DATA_OFFSET) / sizeof(Type) : 0;
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    bool IsReadOnly() const noexcept {
+        return read_only_;
+    }
+
+    void PushBack(const Type& item) {
+        CheckWritable();
+        const size_t size = GetSize();
+        if (size == GetCapacity()) {
+            // item может лежать в отображении, которое сейчас переедет
+            const Type copy = item;
+            Reserve(std::max(GetCapacity() * 2, std::max<size_t>(1, 4096 / sizeof(Type))));
+            Data()[size] = copy;
+        } else {
+            Data()[size] = item;
+        }
+        Header().size = size + 1;
+    }
+
+    void PopBack() noexcept {
+        assert(!IsEmpty() && !read_only_);
+        --Header().size;
+    }
+
+    // Новые элементы инициализируются значением по умолчанию
+    void Resize(size_t new_size) {
+        CheckWritable();
+        const size_t size = GetSize();
+        if (new_size > GetCapacity()) {
+            Reserve(std::max(GetCapacity() * 2, new_size));
+        }
+        if (new_size > size) {
+            std::uninitialized_value_construct(Data() + size, Data() + new_size);
+        }
+        Header().size = new_size;
+    }
+
+    // Увеличивает файл, чтобы в нём поместилось new_capacity элементов
+    void Reserve(size_t new_capacity) {
+        CheckWritable();
+        if (new_capacity > GetCapacity()) {
+            const size_t file_size = DATA_OFFSET + new_capacity * sizeof(Type);
+            Truncate(file_size);
+            Remap(file_size);
+        }
+    }
+
+    // Обрезает файл до занятых элементов
+    void ShrinkToFit() {
+        CheckWritable();
+        const size_t file_size = DATA_OFFSET + GetSize() * sizeof(Type);
+        if (file_size < mapped_bytes_) {
+            Remap(file_size);
+            Truncate(file_size);
+        }
+    }
+
+    void Clear() {
+        CheckWritable();
+        Header().size = 0;
+    }
+
+    // Запускает запись изменённых страниц на диск, не дожидаясь её окончания
+    void Flush() {
+        if (!read_only_ && ::msync(mapping_, mapped_bytes_, MS_ASYNC) != 0) {
+            throw std::system_error(errno, std::generic_category(), "msync");
+        }
+    }
+
+    // Дожидается записи элементов, заголовка и размера файла на диск
+    void Sync() {
+        if (read_only_) {
+            return;
+        }
+        if (::msync(mapping_, mapped_bytes_, MS_SYNC) != 0) {
+            throw std::system_error(errno, std::generic_category(), "msync");
+        }
+        if (::fsync(fd_) != 0) {
+            throw std::system_error(errno, std::generic_category(), "fsync");
+        }
+    }
+
+    Iterator begin() noexcept {
+        return Data();
+    }
+
+    Iterator end() noexcept {
+        return begin() + GetSize();
+    }
+
+    ConstIterator begin() const noexcept {
+        return Data();
+    }
+
+    ConstIterator end() const noexcept {
+        return begin() + GetSize();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    MappedVectorHeader& Header() const noexcept {
+        return *static_cast<MappedVectorHeader*>(mapping_);
+    }
+
+    Type* Data() const noexcept {
+        return mapping_ != nullptr ? reinterpret_cast<Type*>(static_cast<char*>(mapping_) + DATA_OFFSET) : nullptr;
+    }
+
+    void CheckWritable() const {
+        if (read_only_) {
+            throw std::logic_error("MappedSimpleVector is opened read-only");
+        }
+    }
+
+    void CheckHeader(const std::string& path, size_t file_size) const {
+        const MappedVectorHeader& header = Header();
+        if (std::memcmp(header.magic, MappedVectorHeader::MAGIC, sizeof(header.magic)) != 0) {
+            throw std::runtime_error("MappedSimpleVector: " + path + " is not a vector file");
+        }
+        if (header.version != MappedVectorHeader::VERSION) {
+            throw std::runtime_error("MappedSimpleVector: " + path + " has unsupported version "
+                                     + std::to_string(header.version));
+        }
+        if (header.element_size != sizeof(Type) || header.element_alignment != alignof(Type)) {
+            throw std::runtime_error("MappedSimpleVector: " + path + " stores elements of size "
+                                     + std::to_string(header.element_size) + " and alignment "
+                                     + std::to_string(header.element_alignment));
+        }
+        if (header.size > (file_size - DATA_OFFSET) / sizeof(Type)) {
+            throw std::runtime_error("MappedSimpleVector: " + path + " is truncated");
+        }
+    }
+
+    void Truncate(size_t file_size) {
+        if (::ftruncate(fd_, static_cast<off_t>(file_size)) != 0) {
+            throw std::system_error(errno, std::generic_category(), "ftruncate");
+        }
+    }
+
+    void Map(size_t bytes) {
+        const int protection = read_only_ ? PROT_READ : PROT_READ | PROT_WRITE;
+        void* mapping = ::mmap(nullptr, bytes, protection, MAP_SHARED, fd_, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mmap");
+        }
+        mapping_ = mapping;
+        mapped_bytes_ = bytes;
+    }
+
+    void Remap(size_t bytes) {
+#if defined(__linux__)
+        void* mapping = ::mremap(mapping_, mapped_bytes_, bytes, MREMAP_MAYMOVE);
+        if (mapping == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mremap");
+        }
+        mapping_ = mapping;
+        mapped_bytes_ = bytes;
+#else
+        // Страницы общие с файлом, так что новое отображение видит те же данные
+        void* old_mapping = mapping_;
+        const size_t old_bytes = mapped_bytes_;
+        Map(bytes);
+        ::munmap(old_mapping, old_bytes);
+#endif
+    }
+
+    void Close() noexcept {
+        if (mapping_ != nullptr) {
+            ::munmap(mapping_, mapped_bytes_);
+            mapping_ = nullptr;
+            mapped_bytes_ = 0;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    int fd_ = -1;
+    void* mapping_ = nullptr;
+    size_t mapped_bytes_ = 0;
+    bool read_only_ = false;
+};
+
+#endif  // defined(__unix__) || defined(__APPLE__)
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cassert>
+#include <cstdlib>
+#include <stdexcept>
+
+
+// Политики переполнения StaticVector. Политика — тип с
+//     static constexpr bool REJECT;
+//     static void Overflow();
+// Overflow вызывается, когда операция не помещается в вместимость. При REJECT == false
+// он не возвращает управление; при REJECT == true операция ничего не меняет
+// и сообщает о неудаче результатом
+
+// Выбрасывает std::length_error (поведение по умолчанию). Исключение выделяет память,
+// поэтому в обработчиках сигналов нужна другая политика
+struct ThrowOnOverflow {
+    static constexpr bool REJECT = false;
+
+    [[noreturn]] static void Overflow() {
+        throw std::length_error("StaticVector capacity exceeded");
+    }
+};
+
+// Переполнение — ошибка программы: assert в отладочной сборке, std::abort в любой.
+// Не выделяет память и годится для обработчиков сигналов
+struct AbortOnOverflow {
+    static constexpr bool REJECT = false;
+
+    [[noreturn]] static void Overflow() noexcept {
+        assert(!"StaticVector capacity exceeded");
+        std::abort();
+    }
+};
+
+// Операция отклоняется: PushBack, Resize и Append возвращают false, Insert, Emplace
+// и EmplaceBack — nullptr, а вектор остаётся прежним
+struct RejectOnOverflow {
+    static constexpr bool REJECT = true;
+
+    static void Overflow() noexcept {
+    }
+};
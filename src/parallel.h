@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+// Пул потоков с перехватом работы (work stealing). Каждый рабочий поток берёт задачи
+// с конца своей очереди, а когда она пуста — крадёт из начала чужих. Поток, вызвавший
+// ParallelFor, тоже выполняет задачи, пока ждёт завершения, поэтому вложенные вызовы
+// из задач не блокируют пул
+class WorkStealingThreadPool {
+public:
+    // Пул с worker_count рабочими потоками. При worker_count == 0 всё выполняется в вызывающем потоке
+    explicit WorkStealingThreadPool(size_t worker_count) {
+        queues_.reserve(worker_count);
+        for (size_t i = 0; i < worker_count; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        workers_.reserve(worker_count);
+        for (size_t i = 0; i < worker_count; ++i) {
+            workers_.emplace_back([this, i] {
+                WorkerLoop(i);
+            });
+        }
+    }
+
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+    ~WorkStealingThreadPool() {
+        {
+            std::lock_guard lock(sleep_mutex_);
+            stop_ = true;
+        }
+        sleep_cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    // Общий пул: по рабочему потоку на каждое ядро, кроме ядра вызывающего потока
+    static WorkStealingThreadPool& Instance() {
+        static WorkStealingThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return pool;
+    }
+
+    size_t GetWorkerCount() const noexcept {
+        return workers_.size();
+    }
+
+    // Разбивает [0, count) на отрезки длиной не более grain и вызывает body(begin, end)
+    // для каждого, возможно в разных потоках. Возвращает управление, когда все отрезки обработаны.
+    // Если body бросило исключение, оставшиеся отрезки пропускаются, а первое исключение
+    // пробрасывается вызывающему
+    template <typename Body>
+    void ParallelFor(size_t count, size_t grain, Body&& body) {
+        if (count == 0) {
+            return;
+        }
+        grain = std::max<size_t>(grain, 1);
+        const size_t chunks = (count - 1) / grain + 1;
+        if (chunks == 1 || queues_.empty()) {
+            body(size_t{0}, count);
+            return;
+        }
+
+        Job job;
+        job.run = [](void* context, size_t begin, size_t end) {
+            (*static_cast<std::remove_reference_t<Body>*>(context))(begin, end);
+        };
+        job.context = std::addressof(body);
+        job.pending = chunks;
+
+        {
+            std::lock_guard lock(sleep_mutex_);
+            queued_ += chunks;
+        }
+        // Задачи вложенного вызова остаются в очереди текущего рабочего потока,
+        // задачи внешнего вызова раздаются всем очередям по кругу
+        const size_t self = CurrentWorkerIndex();
+        for (size_t i = 0; i < chunks; ++i) {
+            Queue& queue = *queues_[self != NOT_A_WORKER ? self : i % queues_.size()];
+            std::lock_guard lock(queue.mutex);
+            queue.tasks.push_back(Task{&job, i * grain, std::min(count, (i + 1) * grain)});
+        }
+        sleep_cv_.notify_all();
+
+        while (job.pending.load(std::memory_order_acquire) != 0) {
+            Task task;
+            if ((self != NOT_A_WORKER && TryPop(self, task)) || TrySteal(self, task)) {
+                Execute(task);
+                continue;
+            }
+            // Свободных задач нет — остальные отрезки уже выполняются другими потоками
+            std::unique_lock lock(job.mutex);
+            job.done.wait(lock, [&job] {
+                return job.pending.load(std::memory_order_acquire) == 0;
+            });
+        }
+        // Поток, выполнивший последний отрезок, мог ещё не отпустить job.mutex
+        std::lock_guard lock(job.mutex);
+        if (job.error) {
+            std::rethrow_exception(job.error);
+        }
+    }
+
+private:
+    static constexpr size_t NOT_A_WORKER = static_cast<size_t>(-1);
+
+    // Один вызов ParallelFor. Живёт на стеке вызывающего потока до выполнения всех отрезков
+    struct Job {
+        void (*run)(void* context, size_t begin, size_t end) = nullptr;
+        void* context = nullptr;
+        std::atomic<size_t> pending{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+
+    struct Task {
+        Job* job = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // Номер рабочего потока этого пула, выполняющего вызов, или NOT_A_WORKER
+    size_t CurrentWorkerIndex() const noexcept {
+        return current_pool_ == this ? current_index_ : NOT_A_WORKER;
+    }
+
+    bool TryPop(size_t index, Task& task) {
+        Queue& queue = *queues_[index];
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Крадёт самую старую задачу из чужой очереди, начиная со следующей за thief
+    bool TrySteal(size_t thief, Task& task) {
+        const size_t count = queues_.size();
+        const size_t start = thief == NOT_A_WORKER ? 0 : thief + 1;
+        for (size_t i = 0; i < count; ++i) {
+            const size_t victim = (start + i) % count;
+            if (victim == thief) {
+                continue;
+            }
+            Queue& queue = *queues_[victim];
+            std::lock_guard lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void Execute(const Task& task) noexcept {
+        Job& job = *task.job;
+        if (!job.failed.load(std::memory_order_relaxed)) {
+            try {
+                job.run(job.context, task.begin, task.end);
+            } catch (...) {
+                std::lock_guard lock(job.mutex);
+                if (!job.error) {
+                    job.error = std::current_exception();
+                }
+                job.failed.store(true, std::memory_order_relaxed);
+            }
+        }
+        // Уменьшение и оповещение под мьютексом: как только pending станет нулём,
+        // вызывающий поток может вернуться и разрушить job
+        std::lock_guard lock(job.mutex);
+        if (job.pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            job.done.notify_all();
+        }
+    }
+
+    void WorkerLoop(size_t index) {
+        current_pool_ = this;
+        current_index_ = index;
+        while (true) {
+            Task task;
+            if (TryPop(index, task) || TrySteal(index, task)) {
+                Execute(task);
+                continue;
+            }
+            std::unique_lock lock(sleep_mutex_);
+            sleep_cv_.wait(lock, [this] {
+                return stop_ || queued_.load(std::memory_order_relaxed) != 0;
+            });
+            if (stop_ && queued_.load(std::memory_order_relaxed) == 0) {
+                return;
+            }
+        }
+    }
+
+    static inline thread_local const WorkStealingThreadPool* current_pool_ = nullptr;
+    static inline thread_local size_t current_index_ = 0;
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    // Число задач во всех очередях; увеличивается под sleep_mutex_, чтобы не терять пробуждения
+    std::atomic<size_t> queued_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    bool stop_ = false;
+};
+
+// Параметры параллельного выполнения: grain — наименьшее число элементов,
+// обрабатываемых одной задачей (0 — значение по умолчанию для типа элементов)
+class ParallelProxyObj {
+public:
+    explicit ParallelProxyObj(size_t grain)
+        : grain_(grain) {
+    }
+
+    // Отрезок по умолчанию — 256 КБ: достаточно, чтобы накладные расходы на задачу были
+    // незаметны, и каждая задача первой касалась своих страниц памяти
+    template <typename Type>
+    size_t GetGrain() const noexcept {
+        return grain_ != 0 ? grain_ : std::max<size_t>(1, (256 * 1024) / sizeof(Type));
+    }
+
+    size_t grain_;
+};
+
+inline ParallelProxyObj Parallel(size_t grain = 0) {
+    return ParallelProxyObj(grain);
+}
+
+// Параллельно конструирует count элементов в сырой памяти first: без аргументов
+// (value-initialization) или копированием value. Если конструктор может бросить исключение,
+// элементы конструируются в одном потоке, чтобы при ошибке разрушить уже созданные
+template <typename Type, typename... Args>
+void ParallelUninitializedConstruct(Type* first, size_t count, const ParallelProxyObj& parallel, const Args&... value) {
+    static_assert(sizeof...(Args) <= 1);
+    if constexpr (std::is_nothrow_constructible_v<Type, const Args&...>) {
+        WorkStealingThreadPool::Instance().ParallelFor(count, parallel.GetGrain<Type>(), [first, &value...](size_t begin, size_t end) {
+            if constexpr (sizeof...(Args) == 0) {
+                std::uninitialized_value_construct(first + begin, first + end);
+            } else {
+                std::uninitialized_fill(first + begin, first + end, value...);
+            }
+        });
+    } else if constexpr (sizeof...(Args) == 0) {
+        std::uninitialized_value_construct_n(first, count);
+    } else {
+        std::uninitialized_fill_n(first, count, value...);
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+#include "parallel.h"
+#include "simple_vector.h"
+
+
+// Алгоритмы над элементами SimpleVector, выполняемые на общем пуле потоков
+// (WorkStealingThreadPool::Instance()). Вектор делится на отрезки по parallel.GetGrain(),
+// функции вызываются для разных отрезков одновременно, поэтому должны быть потокобезопасны.
+// Если функция бросает исключение, необработанные отрезки пропускаются, а исключение
+// пробрасывается вызывающему; уже обработанные элементы остаются изменёнными
+
+// Дописывает к v count элементов, создавая их параллельно прямо в хвосте через
+// AppendUninitialized: без аргументов (value-initialization) или копированием value.
+// Каждая задача первой касается своих страниц, так что и их выделение ядром распараллеливается.
+// Элементы, которые не тривиально копируемы, создаются в одном потоке обычными методами вектора
+template <typename Type, typename Allocator, typename GrowthPolicy, typename... Args>
+void ParallelAppend(SimpleVector<Type, Allocator, GrowthPolicy>& v, size_t count, const ParallelProxyObj& parallel,
+                    const Args&... value) {
+    if constexpr (std::is_trivially_copyable_v<Type>) {
+        v.AppendUninitialized(count, [count, &parallel, &value...](Type* dest, size_t) {
+            ParallelUninitializedConstruct(dest, count, parallel, value...);
+            return count;
+        });
+    } else if constexpr (sizeof...(Args) == 0) {
+        v.Resize(v.GetSize() + count);
+    } else {
+        v.Insert(v.cend(), count, value...);
+    }
+}
+
+// Изменяет размер v; новые элементы получают значение по умолчанию и создаются параллельно:
+//     SimpleVector<double> v;
+//     ParallelResize(v, size);
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void ParallelResize(SimpleVector<Type, Allocator, GrowthPolicy>& v, size_t new_size,
+                    const ParallelProxyObj& parallel = Parallel()) {
+    if (new_size <= v.GetSize()) {
+        v.Erase(v.begin() + new_size, v.end());
+        return;
+    }
+    ParallelAppend(v, new_size - v.GetSize(), parallel);
+}
+
+// То же, но новые элементы — копии value
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void ParallelResize(SimpleVector<Type, Allocator, GrowthPolicy>& v, size_t new_size, const std::type_identity_t<Type>& value,
+                    const ParallelProxyObj& parallel = Parallel()) {
+    if (new_size <= v.GetSize()) {
+        v.Erase(v.begin() + new_size, v.end());
+        return;
+    }
+    ParallelAppend(v, new_size - v.GetSize(), parallel, value);
+}
+
+// Присваивает всем элементам значение value
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void ParallelFill(SimpleVector<Type, Allocator, GrowthPolicy>& v, const Type& value,
+                  const ParallelProxyObj& parallel = Parallel()) {
+    Type* data = v.begin();
+    WorkStealingThreadPool::Instance().ParallelFor(v.GetSize(), parallel.GetGrain<Type>(), [data, &value](size_t begin, size_t end) {
+        std::fill(data + begin, data + end, value);
+    });
+}
+
+// Вызывает f(item) для каждого элемента
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Function>
+void ParallelForEach(SimpleVector<Type, Allocator, GrowthPolicy>& v, Function f,
+                     const ParallelProxyObj& parallel = Parallel()) {
+    Type* data = v.begin();
+    WorkStealingThreadPool::Instance().ParallelFor(v.GetSize(), parallel.GetGrain<Type>(), [data, &f](size_t begin, size_t end) {
+        std::for_each(data + begin, data + end, f);
+    });
+}
+
+// dest[i] = op(src[i]). Размер dest приводится к размеру src (новые элементы тоже
+// создаются параллельно). src и dest могут быть одним и тем же вектором
+template <typename Type, typename Allocator, typename GrowthPolicy,
+          typename Result, typename ResultAllocator, typename ResultGrowthPolicy, typename UnaryOperation>
+void ParallelTransform(const SimpleVector<Type, Allocator, GrowthPolicy>& src,
+                       SimpleVector<Result, ResultAllocator, ResultGrowthPolicy>& dest, UnaryOperation op,
+                       const ParallelProxyObj& parallel = Parallel()) {
+    ParallelResize(dest, src.GetSize(), parallel);
+    const Type* input = src.begin();
+    Result* output = dest.begin();
+    WorkStealingThreadPool::Instance().ParallelFor(src.GetSize(), parallel.GetGrain<Type>(), [input, output, &op](size_t begin, size_t end) {
+        std::transform(input + begin, input + end, output + begin, op);
+    });
+}
+
+// Сворачивает элементы операцией op, начиная с init. Отрезки сворачиваются независимо,
+// а их результаты — по порядку, поэтому op должна быть ассоциативной (коммутативность не нужна).
+// Result должен иметь конструктор по умолчанию
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Result, typename BinaryOperation>
+Result ParallelReduce(const SimpleVector<Type, Allocator, GrowthPolicy>& v, Result init, BinaryOperation op,
+                      const ParallelProxyObj& parallel = Parallel()) {
+    const size_t grain = parallel.GetGrain<Type>();
+    const size_t chunks = v.IsEmpty() ? 0 : (v.GetSize() - 1) / grain + 1;
+    SimpleVector<Result> partial(chunks);
+    const Type* data = v.begin();
+    WorkStealingThreadPool::Instance().ParallelFor(v.GetSize(), grain, [data, grain, &partial, &op](size_t begin, size_t end) {
+        partial[begin / grain] = std::accumulate(data + begin + 1, data + end, Result(data[begin]), op);
+    });
+    for (const Result& value : partial) {
+        init = op(std::move(init), value);
+    }
+    return init;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+// Тип считается тривиально перемещаемым, если объект можно перенести на новое место
+// побайтовым копированием (memcpy/memmove/realloc), не вызывая у старого объекта деструктор.
+// По умолчанию это все тривиально копируемые типы. Для собственного типа признак
+// можно включить специализацией:
+//     template <>
+//     struct IsTriviallyRelocatable<MyRecord> : std::true_type {};
+template <typename Type>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<Type> {};
+
+template <typename Type>
+inline constexpr bool IsTriviallyRelocatableV = IsTriviallyRelocatable<Type>::value;
+
+// Алгоритмы над неинициализированной памятью. Во время выполнения они сводятся
+// к std::uninitialized_* и memcpy/memmove, а при вычислении на этапе компиляции,
+// где эти функции недоступны, элементы создаются по одному через std::construct_at.
+// Исключение на этапе компиляции прерывает вычисление, поэтому откат там не нужен
+
+// Копирует [first, last) в неинициализированную память dest
+template <typename InputIt, typename Type>
+constexpr Type* UninitializedCopy(InputIt first, InputIt last, Type* dest) {
+    if (std::is_constant_evaluated()) {
+        for (; first != last; ++first, ++dest) {
+            std::construct_at(dest, *first);
+        }
+        return dest;
+    }
+    return std::uninitialized_copy(first, last, dest);
+}
+
+// Перемещает [first, last) в неинициализированную память dest
+template <typename Type>
+constexpr Type* UninitializedMove(Type* first, Type* last, Type* dest) {
+    if (std::is_constant_evaluated()) {
+        for (; first != last; ++first, ++dest) {
+            std::construct_at(dest, std::move(*first));
+        }
+        return dest;
+    }
+    return std::uninitialized_move(first, last, dest);
+}
+
+// Перемещает [first, last) в неинициализированную память dest, если перемещение Type
+// не бросает исключений, и копирует иначе (как std::move_if_noexcept). Если при копировании
+// вылетит исключение, исходные элементы останутся нетронутыми
+template <typename Type>
+constexpr Type* UninitializedMoveIfNoexcept(Type* first, Type* last, Type* dest) {
+    if constexpr (std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>) {
+        return UninitializedMove(first, last, dest);
+    } else {
+        return UninitializedCopy(first, last, dest);
+    }
+}
+
+// Создаёт count копий value в неинициализированной памяти dest
+template <typename Type>
+constexpr Type* UninitializedFillN(Type* dest, size_t count, const Type& value) {
+    if (std::is_constant_evaluated()) {
+        for (; count > 0; --count, ++dest) {
+            std::construct_at(dest, value);
+        }
+        return dest;
+    }
+    return std::uninitialized_fill_n(dest, count, value);
+}
+
+// Создаёт count элементов, инициализированных значением по умолчанию
+template <typename Type>
+constexpr Type* UninitializedValueConstructN(Type* dest, size_t count) {
+    if (std::is_constant_evaluated()) {
+        for (; count > 0; --count, ++dest) {
+            std::construct_at(dest);
+        }
+        return dest;
+    }
+    return std::uninitialized_value_construct_n(dest, count);
+}
+
+// Переносит элементы [first, last) в неинициализированную память dest.
+// Области памяти не должны пересекаться. После вызова [first, last) — сырая память
+template <typename Type>
+constexpr void UninitializedRelocate(Type* first, Type* last, Type* dest) {
+    if (std::is_constant_evaluated()) {
+        UninitializedMove(first, last, dest);
+        std::destroy(first, last);
+    } else if constexpr (IsTriviallyRelocatableV<Type>) {
+        if (first != last) {
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(Type));
+        }
+    } else {
+        std::uninitialized_move(first, last, dest);
+        std::destroy(first, last);
+    }
+}
+
+// Побайтово сдвигает элементы [first, last) на count позиций вправо (count > 0) или влево.
+// Применимо только к тривиально перемещаемым типам. На этапе компиляции элементы
+// переносятся по одному, начиная с того края, куда идёт сдвиг
+template <typename Type>
+constexpr void RelocateShift(Type* first, Type* last, std::ptrdiff_t count) noexcept {
+    static_assert(IsTriviallyRelocatableV<Type>);
+    if (std::is_constant_evaluated()) {
+        if (count > 0) {
+            for (Type* it = last; it != first;) {
+                --it;
+                std::construct_at(it + count, std::move(*it));
+                std::destroy_at(it);
+            }
+        } else {
+            for (Type* it = first; it != last; ++it) {
+                std::construct_at(it + count, std::move(*it));
+                std::destroy_at(it);
+            }
+        }
+    } else if (first != last) {
+        std::memmove(static_cast<void*>(first + count), static_cast<const void*>(first), (last - first) * sizeof(Type));
+    }
+}
@@ -0,0 +1,285 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "allocator.h"
+#include "array_ptr.h"
+#include "geometric_segments.h"
+#include "index_iterator.h"
+#include "simple_vector.h"
+
+
+// Вектор, элементы которого хранятся в сегментах растущего вдвое размера (16, 32, 64, ...).
+// Рост добавляет новый сегмент и ничего не переносит, поэтому PushBack всегда O(1)
+// без всплесков задержки, а ссылки, указатели и итераторы на элементы остаются
+// действительными, пока элемент не удалён. Сегменты перечислены в небольшом
+// каталоге (не больше 60 указателей); номер сегмента по индексу вычисляется через clz
+template <typename Type, typename Allocator = MallocAllocator<Type>>
+class SegmentedVector {
+    using Segments = GeometricSegments<4>;
+    using ItemsPtr = ArrayPtr<Type, Allocator>;
+
+public:
+    using Iterator = IndexIterator<SegmentedVector, Type>;
+    using ConstIterator = IndexIterator<const SegmentedVector, const Type>;
+
+    SegmentedVector() noexcept = default;
+
+    explicit SegmentedVector(const Allocator& alloc) noexcept
+        : alloc_(alloc) {
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    explicit SegmentedVector(size_t size, const Allocator& alloc = Allocator())
+        : SegmentedVector(alloc)
+    {
+        Resize(size);
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    SegmentedVector(size_t size, const Type& value, const Allocator& alloc = Allocator())
+        : SegmentedVector(alloc)
+    {
+        Reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            EmplaceBack(value);
+        }
+    }
+
+    SegmentedVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator())
+        : SegmentedVector(init.begin(), init.end(), alloc) {
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    SegmentedVector(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+        : SegmentedVector(alloc)
+    {
+        if constexpr (IsForwardIteratorV<InputIt>) {
+            Reserve(std::distance(first, last));
+        }
+        for (; first != last; ++first) {
+            EmplaceBack(*first);
+        }
+    }
+
+    SegmentedVector(const SegmentedVector& other)
+        : SegmentedVector(other.begin(), other.end(),
+                          std::allocator_traits<Allocator>::select_on_container_copy_construction(other.alloc_)) {
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+        : alloc_(other.alloc_),
+          segments_(std::move(other.segments_)),
+          size_(std::exchange(other.size_, 0)) {
+    }
+
+    SegmentedVector& operator=(const SegmentedVector& rhs) {
+        if (this != &rhs) {
+            SegmentedVector copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& rhs) noexcept {
+        if (this != &rhs) {
+            SegmentedVector moved(std::move(rhs));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    ~SegmentedVector() {
+        Clear();
+    }
+
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_);
+        const auto [segment, offset] = Segments::Locate(index);
+        return segments_[segment].Get()[offset];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        const auto [segment, offset] = Segments::Locate(index);
+        return segments_[segment].Get()[offset];
+    }
+
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("");
+        }
+        return (*this)[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("");
+        }
+        return (*this)[index];
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return Segments::Capacity(segments_.GetSize());
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Создаёт элемент в конце вектора. Существующие элементы не перемещаются
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        const auto [segment, offset] = Segments::Locate(size_);
+        if (segment == segments_.GetSize()) {
+            AddSegment();
+        }
+        Type* item = new (segments_[segment].Get() + offset) Type(std::forward<Args>(args)...);
+        ++size_;
+        return *item;
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    void PopBack() noexcept {
+        assert(size_ > 0);
+        --size_;
+        const auto [segment, offset] = Segments::Locate(size_);
+        std::destroy_at(segments_[segment].Get() + offset);
+    }
+
+    // Изменяет размер; новые элементы инициализируются значением по умолчанию.
+    // Если конструктор бросает исключение, размер вектора не меняется
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            while (size_ > new_size) {
+                PopBack();
+            }
+            return;
+        }
+        Reserve(new_size);
+        const size_t old_size = size_;
+        try {
+            while (size_ < new_size) {
+                EmplaceBack();
+            }
+        } catch (...) {
+            Resize(old_size);
+            throw;
+        }
+    }
+
+    // Заранее выделяет сегменты под capacity элементов
+    void Reserve(size_t capacity) {
+        while (GetCapacity() < capacity) {
+            AddSegment();
+        }
+    }
+
+    // Освобождает сегменты, в которых не осталось элементов
+    void ShrinkToFit() {
+        while (!segments_.IsEmpty() && Segments::Capacity(segments_.GetSize() - 1) >= size_) {
+            segments_.PopBack();
+        }
+    }
+
+    // Разрушает элементы, сохраняя сегменты
+    void Clear() noexcept {
+        while (size_ > 0) {
+            PopBack();
+        }
+    }
+
+    Allocator GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    void swap(SegmentedVector& other) noexcept {
+        using std::swap;
+        if constexpr (std::allocator_traits<Allocator>::propagate_on_container_swap::value) {
+            swap(alloc_, other.alloc_);
+        }
+        segments_.swap(other.segments_);
+        std::swap(size_, other.size_);
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, size_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    void AddSegment() {
+        segments_.EmplaceBack(Segments::SegmentSize(segments_.GetSize()), alloc_);
+    }
+
+    [[no_unique_address]] Allocator alloc_{};
+    // Каталог сегментов: сегмент k хранит Segments::SegmentSize(k) элементов
+    SimpleVector<ItemsPtr> segments_;
+    size_t size_ = 0;
+};
+
+template <typename Type, typename Allocator>
+inline bool operator==(const SegmentedVector<Type, Allocator>& lhs, const SegmentedVector<Type, Allocator>& rhs) {
+    return (lhs.GetSize() == rhs.GetSize())
+           && std::equal(lhs.begin(), lhs.end(), rhs.begin());  // может бросить исключение
+}
+
+template <typename Type, typename Allocator>
+inline bool operator!=(const SegmentedVector<Type, Allocator>& lhs, const SegmentedVector<Type, Allocator>& rhs) {
+    return !(lhs == rhs);  // может бросить исключение
+}
+
+template <typename Type, typename Allocator>
+inline bool operator<(const SegmentedVector<Type, Allocator>& lhs, const SegmentedVector<Type, Allocator>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());  // может бросить исключение
+}
+
+template <typename Type, typename Allocator>
+inline bool operator<=(const SegmentedVector<Type, Allocator>& lhs, const SegmentedVector<Type, Allocator>& rhs) {
+    return !(rhs < lhs);  // может бросить исключение
+}
+
+template <typename Type, typename Allocator>
+inline bool operator>(const SegmentedVector<Type, Allocator>& lhs, const SegmentedVector<Type, Allocator>& rhs) {
+    return rhs < lhs;  // может бросить исключение
+}
+
+template <typename Type, typename Allocator>
+inline bool operator>=(const SegmentedVector<Type, Allocator>& lhs, const SegmentedVector<Type, Allocator>& rhs) {
+    return rhs <= lhs;  // может бросить исключение
+}
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define SIMPLE_VECTOR_SIMD_SSE2 1
+// AVX2-ядра собираются атрибутом target и выбираются во время выполнения,
+// поэтому сборка не требует -mavx2 и работает на процессорах без AVX2
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMPLE_VECTOR_SIMD_AVX2 1
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+
+// Сравнение массивов арифметических типов для операторов ==, < и поиска первого различия.
+// Байтовые типы сравниваются memcmp, остальные — векторными ядрами SSE2/AVX2.
+// Результат всегда совпадает с поэлементными std::equal и std::lexicographical_compare:
+// знаковые числа упорядочиваются как числа, а не как байты, для float и double
+// -0.0 == 0.0, а NaN не равен ничему и при упорядочивании не отличается ни от чего
+
+// Типы, для которых используются ядра. long double не входит: у него нет векторных сравнений,
+// а часть его байтов — неопределённое заполнение
+template <typename Type>
+inline constexpr bool IsSimdComparableV = std::is_arithmetic_v<Type> && !std::is_same_v<Type, long double>;
+
+namespace simd_compare_detail {
+
+template <typename Type>
+inline constexpr bool IsFloatingV = std::is_same_v<Type, float> || std::is_same_v<Type, double>;
+
+// Беззнаковые байты (включая bool и беззнаковый char) memcmp упорядочивает так же, как оператор <
+template <typename Type>
+inline constexpr bool IsUnsignedByteV = std::is_integral_v<Type> && sizeof(Type) == 1 && std::is_unsigned_v<Type>;
+
+inline unsigned CountTrailingZeros(unsigned mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+// Различаются ли элементы: для равенства — !(a == b), для упорядочивания — a < b || b < a
+template <bool Ordering, typename Type>
+inline bool Differ(Type a, Type b) noexcept {
+    if constexpr (Ordering) {
+        return a < b || b < a;
+    } else {
+        return !(a == b);
+    }
+}
+
+inline size_t FirstDifferentByteScalar(const unsigned char* lhs, const unsigned char* rhs, size_t i, size_t count) noexcept {
+    while (i < count && lhs[i] == rhs[i]) {
+        ++i;
+    }
+    return i;
+}
+
+template <bool Ordering, typename Type>
+size_t FirstDifferentFloatScalar(const Type* lhs, const Type* rhs, size_t i, size_t count) noexcept {
+    while (i < count && !Differ<Ordering>(lhs[i], rhs[i])) {
+        ++i;
+    }
+    return i;
+}
+
+#ifdef SIMPLE_VECTOR_SIMD_SSE2
+inline size_t FirstDifferentByteSse2(const unsigned char* lhs, const unsigned char* rhs, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) ^ 0xFFFFu;
+        if (mask != 0) {
+            return i + CountTrailingZeros(mask);
+        }
+    }
+    return FirstDifferentByteScalar(lhs, rhs, i, count);
+}
+
+template <bool Ordering, typename Type>
+size_t FirstDifferentFloatSse2(const Type* lhs, const Type* rhs, size_t count) noexcept {
+    size_t i = 0;
+    if constexpr (std::is_same_v<Type, float>) {
+        for (; i + 4 <= count; i += 4) {
+            const __m128 a = _mm_loadu_ps(lhs + i);
+            const __m128 b = _mm_loadu_ps(rhs + i);
+            const __m128 diff = Ordering ? _mm_or_ps(_mm_cmplt_ps(a, b), _mm_cmpgt_ps(a, b)) : _mm_cmpneq_ps(a, b);
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_ps(diff));
+            if (mask != 0) {
+                return i + CountTrailingZeros(mask);
+            }
+        }
+    } else {
+        for (; i + 2 <= count; i += 2) {
+            const __m128d a = _mm_loadu_pd(lhs + i);
+            const __m128d b = _mm_loadu_pd(rhs + i);
+            const __m128d diff = Ordering ? _mm_or_pd(_mm_cmplt_pd(a, b), _mm_cmpgt_pd(a, b)) : _mm_cmpneq_pd(a, b);
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_pd(diff));
+            if (mask != 0) {
+                return i + CountTrailingZeros(mask);
+            }
+        }
+    }
+    return FirstDifferentFloatScalar<Ordering>(lhs, rhs, i, count);
+}
+#endif
+
+#ifdef SIMPLE_VECTOR_SIMD_AVX2
+inline bool HasAvx2() noexcept {
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+__attribute__((target("avx2")))
+inline size_t FirstDifferentByteAvx2(const unsigned char* lhs, const unsigned char* rhs, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+        const unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+        if (mask != 0) {
+            return i + CountTrailingZeros(mask);
+        }
+    }
+    return FirstDifferentByteScalar(lhs, rhs, i, count);
+}
+
+// _CMP_NEQ_UQ — «не равны» (NaN даёт истину), _CMP_NEQ_OQ — «меньше или больше» (NaN даёт ложь)
+template <bool Ordering, typename Type>
+__attribute__((target("avx2")))
+size_t FirstDifferentFloatAvx2(const Type* lhs, const Type* rhs, size_t count) noexcept {
+    constexpr int PREDICATE = Ordering ? _CMP_NEQ_OQ : _CMP_NEQ_UQ;
+    size_t i = 0;
+    if constexpr (std::is_same_v<Type, float>) {
+        for (; i + 8 <= count; i += 8) {
+            const __m256 diff = _mm256_cmp_ps(_mm256_loadu_ps(lhs + i), _mm256_loadu_ps(rhs + i), PREDICATE);
+            const unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(diff));
+            if (mask != 0) {
+                return i + CountTrailingZeros(mask);
+            }
+        }
+    } else {
+        for (; i + 4 <= count; i += 4) {
+            const __m256d diff = _mm256_cmp_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i), PREDICATE);
+            const unsigned mask = static_cast<unsigned>(_mm256_movemask_pd(diff));
+            if (mask != 0) {
+                return i + CountTrailingZeros(mask);
+            }
+        }
+    }
+    return FirstDifferentFloatScalar<Ordering>(lhs, rhs, i, count);
+}
+#endif
+
+inline size_t FirstDifferentByte(const unsigned char* lhs, const unsigned char* rhs, size_t count) noexcept {
+#if defined(SIMPLE_VECTOR_SIMD_AVX2)
+    if (HasAvx2()) {
+        return FirstDifferentByteAvx2(lhs, rhs, count);
+    }
+#endif
+#if defined(SIMPLE_VECTOR_SIMD_SSE2)
+    return FirstDifferentByteSse2(lhs, rhs, count);
+#else
+    return FirstDifferentByteScalar(lhs, rhs, 0, count);
+#endif
+}
+
+// Индекс первого элемента, на котором массивы различаются в смысле Differ<Ordering>, или count.
+// Целые числа различаются тогда и только тогда, когда различаются их байты,
+// поэтому для них достаточно найти первый отличающийся байт
+template <bool Ordering, typename Type>
+size_t FirstDifference(const Type* lhs, const Type* rhs, size_t count) noexcept {
+    if constexpr (IsFloatingV<Type>) {
+#if defined(SIMPLE_VECTOR_SIMD_AVX2)
+        if (HasAvx2()) {
+            return FirstDifferentFloatAvx2<Ordering>(lhs, rhs, count);
+        }
+#endif
+#if defined(SIMPLE_VECTOR_SIMD_SSE2)
+        return FirstDifferentFloatSse2<Ordering>(lhs, rhs, count);
+#else
+        return FirstDifferentFloatScalar<Ordering>(lhs, rhs, 0, count);
+#endif
+    } else {
+        return FirstDifferentByte(reinterpret_cast<const unsigned char*>(lhs),
+                                  reinterpret_cast<const unsigned char*>(rhs), count * sizeof(Type)) / sizeof(Type);
+    }
+}
+
+}  // namespace simd_compare_detail
+
+// Сравнения ниже годятся и для вычисления на этапе компиляции: там векторные команды
+// и memcmp недоступны, и они сводятся к обычным алгоритмам стандартной библиотеки
+
+// Возвращает индекс первого элемента, для которого !(lhs[i] == rhs[i]), или count, если такого нет
+template <typename Type>
+constexpr size_t FindFirstMismatch(const Type* lhs, const Type* rhs, size_t count) {
+    if (std::is_constant_evaluated()) {
+        return std::mismatch(lhs, lhs + count, rhs).first - lhs;
+    }
+    if constexpr (IsSimdComparableV<Type>) {
+        return simd_compare_detail::FirstDifference<false>(lhs, rhs, count);
+    } else {
+        return std::mismatch(lhs, lhs + count, rhs).first - lhs;  // может бросить исключение
+    }
+}
+
+// Поэлементное равенство массивов одной длины
+template <typename Type>
+constexpr bool RangesEqual(const Type* lhs, const Type* rhs, size_t count) {
+    if (std::is_constant_evaluated()) {
+        return std::equal(lhs, lhs + count, rhs);
+    }
+    if constexpr (IsSimdComparableV<Type> && !simd_compare_detail::IsFloatingV<Type>) {
+        return count == 0 || std::memcmp(lhs, rhs, count * sizeof(Type)) == 0;
+    } else if constexpr (IsSimdComparableV<Type>) {
+        return simd_compare_detail::FirstDifference<false>(lhs, rhs, count) == count;
+    } else {
+        return std::equal(lhs, lhs + count, rhs);  // может бросить исключение
+    }
+}
+
+// Лексикографическое сравнение lhs < rhs
+template <typename Type>
+constexpr bool RangesLess(const Type* lhs, size_t lhs_size, const Type* rhs, size_t rhs_size) {
+    if (std::is_constant_evaluated()) {
+        return std::lexicographical_compare(lhs, lhs + lhs_size, rhs, rhs + rhs_size);
+    }
+    const size_t count = std::min(lhs_size, rhs_size);
+    if constexpr (simd_compare_detail::IsUnsignedByteV<Type>) {
+        const int result = count == 0 ? 0 : std::memcmp(lhs, rhs, count);
+        return result != 0 ? result < 0 : lhs_size < rhs_size;
+    } else if constexpr (IsSimdComparableV<Type>) {
+        const size_t i = simd_compare_detail::FirstDifference<true>(lhs, rhs, count);
+        return i != count ? lhs[i] < rhs[i] : lhs_size < rhs_size;
+    } else {
+        return std::lexicographical_compare(lhs, lhs + lhs_size, rhs, rhs + rhs_size);  // может бросить исключение
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+#include "aligned_allocator.h"
+#include "growth_policy.h"
+#include "simple_vector.h"
+
+
+// SimpleVector, begin() которого выровнен на Alignment байт при любом перевыделении
+// (PushBack, Insert, Reserve, Resize, ShrinkToFit). По умолчанию вместимость при росте
+// добирается до кратного Alignment байт; чтобы отказаться от этого, передайте
+// GrowthPolicy = DoublingGrowth. В любом случае первые
+// AlignedAllocator<Type, Alignment>::PaddedSize(GetSize()) элементов памяти доступны для
+// чтения, поэтому векторный цикл может обработать хвост полным регистром
+template <typename Type, size_t Alignment = 64, typename GrowthPolicy = PaddedGrowth<Alignment>>
+using SimpleAlignedVector = SimpleVector<Type, AlignedAllocator<Type, Alignment>, GrowthPolicy>;
@@ -0,0 +1,532 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "allocator.h"
+#include "simd_compare.h"
+#include "simple_vector.h"
+
+
+namespace bit_vector_detail {
+
+inline constexpr size_t WORD_BITS = 64;
+
+inline size_t WordCount(size_t bits) noexcept {
+    return (bits + WORD_BITS - 1) / WORD_BITS;
+}
+
+// Маска младших bits битов слова (bits от 0 до 63)
+inline uint64_t LowMask(size_t bits) noexcept {
+    return (uint64_t{1} << bits) - 1;
+}
+
+inline size_t PopCount(uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcountll(word));
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<size_t>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+inline size_t CountTrailingZeros(uint64_t word) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<size_t>(index);
+#else
+    return static_cast<size_t>(__builtin_ctzll(word));
+#endif
+}
+
+inline size_t CountBitsScalar(const uint64_t* words, size_t count) noexcept {
+    size_t result = 0;
+    for (size_t i = 0; i < count; ++i) {
+        result += PopCount(words[i]);
+    }
+    return result;
+}
+
+enum class BitOp {
+    AND,
+    OR,
+    XOR,
+};
+
+template <BitOp Op>
+inline uint64_t Apply(uint64_t lhs, uint64_t rhs) noexcept {
+    if constexpr (Op == BitOp::AND) {
+        return lhs & rhs;
+    } else if constexpr (Op == BitOp::OR) {
+        return lhs | rhs;
+    } else {
+        return lhs ^ rhs;
+    }
+}
+
+template <BitOp Op>
+void CombineScalar(uint64_t* dest, const uint64_t* src, size_t i, size_t count) noexcept {
+    for (; i < count; ++i) {
+        dest[i] = Apply<Op>(dest[i], src[i]);
+    }
+}
+
+inline void InvertScalar(uint64_t* words, size_t i, size_t count) noexcept {
+    for (; i < count; ++i) {
+        words[i] = ~words[i];
+    }
+}
+
+#ifdef SIMPLE_VECTOR_SIMD_SSE2
+template <BitOp Op>
+inline __m128i Apply(__m128i lhs, __m128i rhs) noexcept {
+    if constexpr (Op == BitOp::AND) {
+        return _mm_and_si128(lhs, rhs);
+    } else if constexpr (Op == BitOp::OR) {
+        return _mm_or_si128(lhs, rhs);
+    } else {
+        return _mm_xor_si128(lhs, rhs);
+    }
+}
+
+template <BitOp Op>
+void CombineSse2(uint64_t* dest, const uint64_t* src, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), Apply<Op>(a, b));
+    }
+    CombineScalar<Op>(dest, src, i, count);
+}
+
+inline void InvertSse2(uint64_t* words, size_t count) noexcept {
+    const __m128i ones = _mm_set1_epi32(-1);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(words + i), _mm_xor_si128(a, ones));
+    }
+    InvertScalar(words, i, count);
+}
+#endif
+
+#ifdef SIMPLE_VECTOR_SIMD_AVX2
+inline bool HasPopcnt() noexcept {
+    static const bool has_popcnt = __builtin_cpu_supports("popcnt");
+    return has_popcnt;
+}
+
+// Тот же цикл, но __builtin_popcountll превращается в одну команду popcnt
+__attribute__((target("popcnt")))
+inline size_t CountBitsPopcnt(const uint64_t* words, size_t count) noexcept {
+    size_t result = 0;
+    for (size_t i = 0; i < count; ++i) {
+        result += static_cast<size_t>(__builtin_popcountll(words[i]));
+    }
+    return result;
+}
+
+template <BitOp Op>
+__attribute__((target("avx2")))
+void CombineAvx2(uint64_t* dest, const uint64_t* src, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dest + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i result;
+        if constexpr (Op == BitOp::AND) {
+            result = _mm256_and_si256(a, b);
+        } else if constexpr (Op == BitOp::OR) {
+            result = _mm256_or_si256(a, b);
+        } else {
+            result = _mm256_xor_si256(a, b);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), result);
+    }
+    CombineScalar<Op>(dest, src, i, count);
+}
+
+__attribute__((target("avx2")))
+inline void InvertAvx2(uint64_t* words, size_t count) noexcept {
+    const __m256i ones = _mm256_set1_epi32(-1);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(words + i), _mm256_xor_si256(a, ones));
+    }
+    InvertScalar(words, i, count);
+}
+#endif
+
+inline size_t CountBits(const uint64_t* words, size_t count) noexcept {
+#if defined(SIMPLE_VECTOR_SIMD_AVX2)
+    if (HasPopcnt()) {
+        return CountBitsPopcnt(words, count);
+    }
+#endif
+    return CountBitsScalar(words, count);
+}
+
+// dest[i] = dest[i] Op src[i] для count слов
+template <BitOp Op>
+void Combine(uint64_t* dest, const uint64_t* src, size_t count) noexcept {
+#if defined(SIMPLE_VECTOR_SIMD_AVX2)
+    if (simd_compare_detail::HasAvx2()) {
+        CombineAvx2<Op>(dest, src, count);
+        return;
+    }
+#endif
+#if defined(SIMPLE_VECTOR_SIMD_SSE2)
+    CombineSse2<Op>(dest, src, count);
+#else
+    CombineScalar<Op>(dest, src, 0, count);
+#endif
+}
+
+inline void Invert(uint64_t* words, size_t count) noexcept {
+#if defined(SIMPLE_VECTOR_SIMD_AVX2)
+    if (simd_compare_detail::HasAvx2()) {
+        InvertAvx2(words, count);
+        return;
+    }
+#endif
+#if defined(SIMPLE_VECTOR_SIMD_SSE2)
+    InvertSse2(words, count);
+#else
+    InvertScalar(words, 0, count);
+#endif
+}
+
+}  // namespace bit_vector_detail
+
+// Вектор флагов, упакованных по 64 в слово uint64_t: в 8 раз меньше памяти, чем
+// SimpleVector<bool>, а подсчёт, поиск и побитовые операции над векторами идут
+// целыми словами (AND/OR/XOR/NOT — векторными командами SSE2/AVX2).
+// operator[] возвращает прокси Reference. Биты последнего слова за пределами размера
+// всегда нулевые, поэтому Count и сравнение работают со словами без масок.
+// Отдельный класс, а не специализация SimpleVector<bool>: прокси вместо bool&
+// не удовлетворяет интерфейсу SimpleVector, и обычный вектор флагов остаётся доступен
+template <typename Allocator = MallocAllocator<uint64_t>>
+class SimpleBitVector {
+    using Words = SimpleVector<uint64_t, Allocator>;
+
+public:
+    // Ссылка на один бит
+    class Reference {
+    public:
+        Reference(uint64_t* word, uint64_t mask) noexcept
+            : word_(word),
+              mask_(mask) {
+        }
+
+        Reference(const Reference&) = default;
+
+        Reference& operator=(bool value) noexcept {
+            if (value) {
+                *word_ |= mask_;
+            } else {
+                *word_ &= ~mask_;
+            }
+            return *this;
+        }
+
+        Reference& operator=(const Reference& other) noexcept {
+            return *this = static_cast<bool>(other);
+        }
+
+        operator bool() const noexcept {
+            return (*word_ & mask_) != 0;
+        }
+
+        bool operator~() const noexcept {
+            return !static_cast<bool>(*this);
+        }
+
+        void Flip() noexcept {
+            *word_ ^= mask_;
+        }
+
+    private:
+        uint64_t* word_;
+        uint64_t mask_;
+    };
+
+    SimpleBitVector() noexcept = default;
+
+    explicit SimpleBitVector(const Allocator& alloc) noexcept
+        : words_(alloc) {
+    }
+
+    // Создаёт вектор из size флагов со значением value
+    explicit SimpleBitVector(size_t size, bool value = false, const Allocator& alloc = Allocator())
+        : words_(bit_vector_detail::WordCount(size), value ? ~uint64_t{0} : uint64_t{0}, alloc),
+          size_(size) {
+        ClearTail();
+    }
+
+    SimpleBitVector(std::initializer_list<bool> init, const Allocator& alloc = Allocator())
+        : words_(alloc) {
+        Reserve(init.size());
+        for (bool value : init) {
+            PushBack(value);
+        }
+    }
+
+    Reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Reference(words_.begin() + index / bit_vector_detail::WORD_BITS, Mask(index));
+    }
+
+    bool operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return (words_[index / bit_vector_detail::WORD_BITS] & Mask(index)) != 0;
+    }
+
+    Reference At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("");
+        }
+        return (*this)[index];
+    }
+
+    bool At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("");
+        }
+        return (*this)[index];
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Вместимость в битах
+    size_t GetCapacity() const noexcept {
+        return words_.GetCapacity() * bit_vector_detail::WORD_BITS;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    void PushBack(bool value) {
+        if (size_ % bit_vector_detail::WORD_BITS == 0) {
+            words_.PushBack(0);
+        }
+        if (value) {
+            words_[size_ / bit_vector_detail::WORD_BITS] |= Mask(size_);
+        }
+        ++size_;
+    }
+
+    // Добавляет count младших битов word (count от 1 до 64) одной-двумя записями слов
+    void AppendWord(uint64_t word, size_t count = bit_vector_detail::WORD_BITS) {
+        assert(count > 0 && count <= bit_vector_detail::WORD_BITS);
+        if (count < bit_vector_detail::WORD_BITS) {
+            word &= bit_vector_detail::LowMask(count);
+        }
+        const size_t offset = size_ % bit_vector_detail::WORD_BITS;
+        if (offset == 0) {
+            words_.PushBack(word);
+        } else {
+            words_[words_.GetSize() - 1] |= word << offset;
+            if (offset + count > bit_vector_detail::WORD_BITS) {
+                words_.PushBack(word >> (bit_vector_detail::WORD_BITS - offset));
+            }
+        }
+        size_ += count;
+    }
+
+    void PopBack() noexcept {
+        assert(size_ > 0);
+        --size_;
+        words_[size_ / bit_vector_detail::WORD_BITS] &= ~Mask(size_);
+        if (size_ % bit_vector_detail::WORD_BITS == 0) {
+            words_.PopBack();
+        }
+    }
+
+    // Изменяет размер; новые флаги получают значение value. Слова заполняются целиком
+    void Resize(size_t new_size, bool value = false) {
+        const size_t old_size = size_;
+        words_.Resize(bit_vector_detail::WordCount(new_size));
+        size_ = new_size;
+        if (new_size > old_size) {
+            if (value) {
+                // Хвост старого последнего слова, затем целые слова
+                const size_t offset = old_size % bit_vector_detail::WORD_BITS;
+                const size_t first_word = bit_vector_detail::WordCount(old_size);
+                if (offset != 0) {
+                    words_[first_word - 1] |= ~bit_vector_detail::LowMask(offset);
+                }
+                std::fill(words_.begin() + first_word, words_.end(), ~uint64_t{0});
+            }
+        }
+        ClearTail();
+    }
+
+    // Заранее выделяет память под capacity битов
+    void Reserve(size_t capacity) {
+        words_.Reserve(bit_vector_detail::WordCount(capacity));
+    }
+
+    void ShrinkToFit() {
+        words_.ShrinkToFit();
+    }
+
+    void Clear() noexcept {
+        words_.Clear();
+        size_ = 0;
+    }
+
+    // Присваивает всем флагам значение value
+    void Fill(bool value) noexcept {
+        std::fill(words_.begin(), words_.end(), value ? ~uint64_t{0} : uint64_t{0});
+        ClearTail();
+    }
+
+    // Число установленных флагов
+    size_t Count() const noexcept {
+        return bit_vector_detail::CountBits(words_.begin(), words_.GetSize());
+    }
+
+    // Число установленных флагов среди первых pos (pos <= GetSize())
+    size_t Rank(size_t pos) const noexcept {
+        assert(pos <= size_);
+        const size_t full_words = pos / bit_vector_detail::WORD_BITS;
+        size_t result = bit_vector_detail::CountBits(words_.begin(), full_words);
+        const size_t rest = pos % bit_vector_detail::WORD_BITS;
+        if (rest != 0) {
+            result += bit_vector_detail::PopCount(words_[full_words] & bit_vector_detail::LowMask(rest));
+        }
+        return result;
+    }
+
+    // Индекс первого установленного флага или GetSize(), если таких нет
+    size_t FindFirst() const noexcept {
+        return FindNext(0);
+    }
+
+    // Индекс первого установленного флага, не меньший pos, или GetSize()
+    size_t FindNext(size_t pos) const noexcept {
+        if (pos >= size_) {
+            return size_;
+        }
+        size_t word_index = pos / bit_vector_detail::WORD_BITS;
+        uint64_t word = words_[word_index] & ~bit_vector_detail::LowMask(pos % bit_vector_detail::WORD_BITS);
+        while (word == 0) {
+            if (++word_index == words_.GetSize()) {
+                return size_;
+            }
+            word = words_[word_index];
+        }
+        return word_index * bit_vector_detail::WORD_BITS + bit_vector_detail::CountTrailingZeros(word);
+    }
+
+    // Побитовые операции с вектором того же размера. При разных размерах выбрасывают std::invalid_argument
+    SimpleBitVector& operator&=(const SimpleBitVector& rhs) {
+        return Combine<bit_vector_detail::BitOp::AND>(rhs);
+    }
+
+    SimpleBitVector& operator|=(const SimpleBitVector& rhs) {
+        return Combine<bit_vector_detail::BitOp::OR>(rhs);
+    }
+
+    SimpleBitVector& operator^=(const SimpleBitVector& rhs) {
+        return Combine<bit_vector_detail::BitOp::XOR>(rhs);
+    }
+
+    // Инвертирует все флаги
+    SimpleBitVector& Flip() noexcept {
+        bit_vector_detail::Invert(words_.begin(), words_.GetSize());
+        ClearTail();
+        return *this;
+    }
+
+    // Слова с флагами: бит i лежит в слове i / 64 на позиции i % 64
+    const uint64_t* GetWords() const noexcept {
+        return words_.begin();
+    }
+
+    size_t GetWordCount() const noexcept {
+        return words_.GetSize();
+    }
+
+    Allocator GetAllocator() const noexcept {
+        return words_.GetAllocator();
+    }
+
+    void swap(SimpleBitVector& other) noexcept {
+        words_.swap(other.words_);
+        std::swap(size_, other.size_);
+    }
+
+private:
+    static uint64_t Mask(size_t index) noexcept {
+        return uint64_t{1} << (index % bit_vector_detail::WORD_BITS);
+    }
+
+    // Обнуляет биты последнего слова за пределами размера
+    void ClearTail() noexcept {
+        const size_t rest = size_ % bit_vector_detail::WORD_BITS;
+        if (rest != 0) {
+            words_[words_.GetSize() - 1] &= bit_vector_detail::LowMask(rest);
+        }
+    }
+
+    template <bit_vector_detail::BitOp Op>
+    SimpleBitVector& Combine(const SimpleBitVector& rhs) {
+        if (rhs.size_ != size_) {
+            throw std::invalid_argument("SimpleBitVector: sizes differ");
+        }
+        bit_vector_detail::Combine<Op>(words_.begin(), rhs.words_.begin(), words_.GetSize());
+        return *this;
+    }
+
+    Words words_;
+    size_t size_ = 0;
+};
+
+template <typename Allocator>
+inline bool operator==(const SimpleBitVector<Allocator>& lhs, const SimpleBitVector<Allocator>& rhs) noexcept {
+    return lhs.GetSize() == rhs.GetSize()
+           && RangesEqual(lhs.GetWords(), rhs.GetWords(), lhs.GetWordCount());
+}
+
+template <typename Allocator>
+inline bool operator!=(const SimpleBitVector<Allocator>& lhs, const SimpleBitVector<Allocator>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+template <typename Allocator>
+SimpleBitVector<Allocator> operator&(SimpleBitVector<Allocator> lhs, const SimpleBitVector<Allocator>& rhs) {
+    lhs &= rhs;
+    return lhs;
+}
+
+template <typename Allocator>
+SimpleBitVector<Allocator> operator|(SimpleBitVector<Allocator> lhs, const SimpleBitVector<Allocator>& rhs) {
+    lhs |= rhs;
+    return lhs;
+}
+
+template <typename Allocator>
+SimpleBitVector<Allocator> operator^(SimpleBitVector<Allocator> lhs, const SimpleBitVector<Allocator>& rhs) {
+    lhs ^= rhs;
+    return lhs;
+}
+
+template <typename Allocator>
+SimpleBitVector<Allocator> operator~(SimpleBitVector<Allocator> v) {
+    v.Flip();
+    return v;
+}
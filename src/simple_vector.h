@@ -4,225 +4,398 @@
 #include <cassert>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
+#include <new>
 #include <stdexcept>
 #include <functional>
 #include <utility>
 
+#include "allocator.h"
 #include "array_ptr.h"
+#include "growth_policy.h"
+#include "relocation.h"
+#include "simd_compare.h"
+
+#ifdef SIMPLE_VECTOR_STATS
+#include <typeinfo>
+
+#include "simple_vector_stats.h"
+#endif
 
 
 class ReserveProxyObj {
 public:
-    ReserveProxyObj(size_t capacity)
+    constexpr ReserveProxyObj(size_t capacity)
         : capacity_(capacity) {
     }
 
     size_t capacity_;
 };
 
-ReserveProxyObj Reserve(size_t capacity_to_reserve) {
+constexpr ReserveProxyObj Reserve(size_t capacity_to_reserve) {
     return ReserveProxyObj(capacity_to_reserve);
 }
 
-template <typename Type>
+// Проверяет, что It — итератор (а не, например, целое число),
+// чтобы диапазонные перегрузки не перехватывали вызовы вида (size, value)
+template <typename It, typename = void>
+struct IsInputIterator : std::false_type {};
+
+template <typename It>
+struct IsInputIterator<It, std::enable_if_t<std::is_convertible_v<
+        typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag>>> : std::true_type {};
+
+template <typename It>
+inline constexpr bool IsInputIteratorV = IsInputIterator<It>::value;
+
+template <typename It>
+inline constexpr bool IsForwardIteratorV = std::is_convertible_v<
+        typename std::iterator_traits<It>::iterator_category, std::forward_iterator_tag>;
+
+// Allocator — std-совместимый аллокатор (MallocAllocator, ArenaAllocator,
+// std::pmr::polymorphic_allocator и т.п.). Память берётся у аллокатора,
+// элементы конструируются в ней напрямую.
+// GrowthPolicy — политика роста вместимости из growth_policy.h
+template <typename Type, typename Allocator = MallocAllocator<Type>, typename GrowthPolicy = DoublingGrowth>
 class SimpleVector {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
 public:
-    using ItemsPtr = ArrayPtr<Type>;
+    using ItemsPtr = ArrayPtr<Type, Allocator>;
     using Iterator = Type*;
     using ConstIterator = const Type*;
+    using AllocatorType = Allocator;
 
-    SimpleVector() noexcept = default;
+    constexpr SimpleVector() noexcept = default;
+
+    // Создаёт пустой вектор, берущий память у аллокатора alloc
+    constexpr explicit SimpleVector(const Allocator& alloc) noexcept
+        : items_(alloc)
+    {
+    }
 
     // Создаёт вектор из size элементов, инициализированных значением по умолчанию
-    explicit SimpleVector(size_t size)
-        : items_(size),
-          size_(size),
-          capacity_(size)
+    constexpr explicit SimpleVector(size_t size, const Allocator& alloc = Allocator())
+        : items_(size, alloc)
     {
-        std::generate(begin(), end(), [](){return Type();});
+        ReportStorage(0, GetCapacity(), 0);
+        UninitializedValueConstructN(items_.Get(), size);
+        size_ = size;
     }
 
     // Создаёт вектор из size элементов, инициализированных значением value
-    SimpleVector(size_t size, const Type& value)
-        : items_(size),
-          size_(size),
-          capacity_(size)
-
+    constexpr SimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator())
+        : items_(size, alloc)
     {
-        std::fill(begin(), end(), value);
+        ReportStorage(0, GetCapacity(), 0);
+        UninitializedFillN(items_.Get(), size, value);
+        size_ = size;
     }
 
     // Создаёт вектор из std::initializer_list
-    SimpleVector(std::initializer_list<Type> init)
-        : items_(init.size()),
-          size_(init.size()),
-          capacity_(init.size())
+    constexpr SimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator())
+        : items_(init.size(), alloc)
     {
-        std::move(init.begin(), init.end(), begin());
+        ReportStorage(0, GetCapacity(), 0);
+        UninitializedCopy(init.begin(), init.end(), items_.Get());
+        size_ = init.size();
+    }
+
+    // Создаёт вектор из элементов диапазона [first, last).
+    // Для forward-итераторов память выделяется один раз
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    constexpr SimpleVector(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+        : items_(alloc)
+    {
+        Append(first, last);
     }
 
     // Создаёт пустой вектор и резервирует необходимую память
-    explicit SimpleVector(const ReserveProxyObj& proxyObj) {
+    constexpr explicit SimpleVector(const ReserveProxyObj& proxyObj, const Allocator& alloc = Allocator())
+        : items_(alloc)
+    {
         Reserve(proxyObj.capacity_);
     }
 
     // конструктор копирования
-    SimpleVector(const SimpleVector& other) {
-        ArrayPtr<Type> new_items(other.GetSize());
-        std::copy(other.begin(), other.end(), new_items.Get());
-        items_.swap(new_items);
+    constexpr SimpleVector(const SimpleVector& other)
+        : SimpleVector(other, AllocTraits::select_on_container_copy_construction(other.GetAllocator()))
+    {
+    }
+
+    // Копирует other, беря память у аллокатора alloc
+    constexpr SimpleVector(const SimpleVector& other, const Allocator& alloc)
+        : items_(other.GetSize(), alloc)
+    {
+        ReportStorage(0, GetCapacity(), 0);
+        UninitializedCopy(other.begin(), other.end(), items_.Get());
         size_ = other.GetSize();
-        capacity_ = other.GetCapacity();
     }
 
-    SimpleVector& operator=(const SimpleVector& rhs) {
+    constexpr ~SimpleVector() {
+        ReportStorage(GetCapacity(), 0, 0);
+        Clear();
+    }
+
+    // Если элементы копируются без исключений, вместимости хватает и аллокатор менять
+    // не нужно, копия пишется в имеющийся буфер без выделения памяти. Иначе она строится
+    // в новом буфере и обменивается с текущим. В обоих случаях при исключении вектор не меняется
+    constexpr SimpleVector& operator=(const SimpleVector& rhs) {
         if (this == &rhs) {
             return *this;
         }
-        SimpleVector new_vector(rhs);
+        constexpr bool NOTHROW_COPY = std::is_nothrow_copy_constructible_v<Type> && std::is_nothrow_copy_assignable_v<Type>;
+        if constexpr (NOTHROW_COPY) {
+            if (rhs.size_ <= GetCapacity()
+                && (!AllocTraits::propagate_on_container_copy_assignment::value || GetAllocator() == rhs.GetAllocator())) {
+                AssignInPlace(rhs.begin(), rhs.size_);
+                return *this;
+            }
+        }
+        // Копия создаётся с тем аллокатором, который вектор должен получить в итоге,
+        // поэтому обмен буферами не нарушает правил распространения аллокатора
+        SimpleVector new_vector(rhs, AllocTraits::propagate_on_container_copy_assignment::value
+                                         ? rhs.GetAllocator()
+                                         : GetAllocator());
         swap(new_vector);
         return *this;
     }
 
-    SimpleVector(SimpleVector&& other) noexcept
+    constexpr SimpleVector(SimpleVector&& other) noexcept
         : items_(std::move(other.items_)),
-        size_(other.size_),
-        capacity_(other.capacity_)
+        size_(std::exchange(other.size_, 0))
     {
-        other.Clear();
     }
 
-    SimpleVector& operator=(SimpleVector&& rhs) noexcept{
-        if (items_.Get() != rhs.items_.Get()) {
-            Resize(rhs.size_);
-            std::move(rhs.begin(), rhs.end(), begin());
+    // Забирает буфер rhs за O(1) без выделения памяти. rhs остаётся пустым, но получает
+    // буфер этого вектора и может снова заполнить его без выделений — удобно для
+    // двойной буферизации. Если аллокаторы не равны и не распространяются, элементы
+    // перемещаются по одному в память этого вектора
+    constexpr SimpleVector& operator=(SimpleVector&& rhs) noexcept(STEALS_ON_MOVE) {
+        if (this == &rhs) {
+            return *this;
+        }
+        if (STEALS_ON_MOVE || GetAllocator() == rhs.GetAllocator()) {
+            Clear();
+            items_.swap(rhs.items_);
+            size_ = std::exchange(rhs.size_, 0);
+            return *this;
+        }
+        if (rhs.size_ <= GetCapacity()) {
+            AssignInPlace(std::make_move_iterator(rhs.begin()), rhs.size_);
+        } else {
+            SimpleVector moved(std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()), GetAllocator());
+            swap(moved);
         }
+        rhs.Clear();
         return *this;
     }
 
     // Возвращает ссылку на элемент с индексом index
-    Type& operator[](size_t index) noexcept {
+    constexpr Type& operator[](size_t index) noexcept {
         assert(index < GetSize());
         return items_[index];
     }
 
     // Возвращает константную ссылку на элемент с индексом index
-    const Type& operator[](size_t index) const noexcept {
+    constexpr const Type& operator[](size_t index) const noexcept {
         assert(index < GetSize());
         return items_[index];
 
     }
 
-    void PushBack(const Type& item) {
-        if (size_ == capacity_) {
-            const size_t new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
-            ArrayPtr<Type> new_items(new_capacity);
-            std::move(begin(), end(), new_items.Get());
-            items_.swap(new_items);
-            capacity_ = new_capacity;
-        }
-        items_[size_] = item;
-        ++size_;
-    }
-    
-    void PushBack(Type&& item) {
-        if (size_ == capacity_) {
-            ArrayPtr<Type> new_items(capacity_ == 0 ? 1 : capacity_ * 2);
-            std::move(begin(), end(), new_items.Get());
-            items_.swap(new_items);
-            capacity_ = capacity_ == 0 ? 1 : capacity_ * 2;
-        }
-        items_[size_] = std::move(item);
-        ++size_;
+    constexpr void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    constexpr void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Создаёт элемент в конце вектора из аргументов args, не создавая временных объектов.
+    // Аргументы могут ссылаться на элементы самого вектора.
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    constexpr Type& EmplaceBack(Args&&... args) {
+        return *EmplaceAt(size_, std::forward<Args>(args)...);
+    }
+
+    // Создаёт элемент из аргументов args в позиции pos.
+    // Возвращает итератор на созданный элемент
+    template <typename... Args>
+    constexpr Iterator Emplace(ConstIterator pos, Args&&... args) {
+        assert(pos >= begin() && pos <= end());
+        return EmplaceAt(pos - cbegin(), std::forward<Args>(args)...);
     }
 
     // Вставляет значение value в позицию pos.
     // Возвращает итератор на вставленное значение
     // Если перед вставкой значения вектор был заполнен полностью,
-    // вместимость вектора должна увеличиться вдвое, а для вектора вместимостью 0 стать равной 1
-    Iterator Insert(ConstIterator pos, const Type& value) {
-        //assert(pos >= begin() && pos < end());
-        if (size_ == capacity_) {
-            size_t new_capacity = (capacity_ == 0 ? 1 : capacity_ * 2);
-            ArrayPtr<Type> new_items(new_capacity);
-            const auto dist = std::distance(cbegin(), pos);
-            std::move(begin(), const_cast<Iterator>(pos), new_items.Get());
-            std::move(const_cast<Iterator>(pos), end(), new_items.Get() + dist + 1);
-            new_items[dist] = value;
-            items_.swap(new_items);
-            ++size_;
-            capacity_ = new_capacity;
-            return begin() + dist;
+    // новую вместимость выбирает политика роста GrowthPolicy
+    constexpr Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    constexpr Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Вставляет count копий value в позицию pos. Память перевыделяется не более одного раза,
+    // хвост сдвигается один раз. Возвращает итератор на первый вставленный элемент
+    constexpr Iterator Insert(ConstIterator pos, size_t count, const Type& value) {
+        assert(pos >= begin() && pos <= end());
+        const size_t dist = pos - cbegin();
+        // На этапе компиляции указатели на разные объекты сравнивать нельзя, и value копируется всегда
+        if (std::is_constant_evaluated()
+            || (std::less_equal<const Type*>()(cbegin(), &value) && std::less<const Type*>()(&value, cend()))) {
+            // value — элемент самого вектора, который может быть сдвинут или перенесён
+            const Type copy(value);
+            return InsertN(dist, count, [&](Type* dest) {
+                UninitializedFillN(dest, count, copy);
+            });
         }
-        std::copy_backward(const_cast<Iterator>(pos), end(), end() + 1);
-        items_[pos - items_.Get()] = value;
-        ++size_;
-        return const_cast<Iterator>(pos);
-    }
-
-    Iterator Insert(ConstIterator pos, Type&& value) {
-        // assert(pos >= begin() && pos < end());
-        if (size_ == capacity_) {
-            size_t new_capacity = (capacity_ == 0 ? 1 : capacity_ * 2);
-            ArrayPtr<Type> new_items(new_capacity);
-            const auto dist = std::distance(cbegin(), pos);
-            std::move(begin(), const_cast<Iterator>(pos), new_items.Get());
-            std::move(const_cast<Iterator>(pos), end(), new_items.Get() + dist + 1);
-            new_items[dist] = std::move(value);
-            items_.swap(new_items);
-            ++size_;
-            capacity_ = new_capacity;
-            return begin() + dist;
+        return InsertN(dist, count, [&](Type* dest) {
+            UninitializedFillN(dest, count, value);
+        });
+    }
+
+    // Вставляет элементы диапазона [first, last) в позицию pos. Для forward-итераторов
+    // память перевыделяется не более одного раза, а хвост сдвигается один раз.
+    // Диапазон не должен указывать на элементы самого вектора.
+    // Возвращает итератор на первый вставленный элемент
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    constexpr Iterator Insert(ConstIterator pos, InputIt first, InputIt last) {
+        assert(pos >= begin() && pos <= end());
+        const size_t dist = pos - cbegin();
+        if constexpr (IsForwardIteratorV<InputIt>) {
+            const size_t count = std::distance(first, last);
+            return InsertN(dist, count, [&](Type* dest) {
+                UninitializedCopy(first, last, dest);
+            });
+        } else {
+            // Однопроходный диапазон сначала собирается во временный вектор
+            SimpleVector buffer(items_.GetAllocator());
+            for (; first != last; ++first) {
+                buffer.EmplaceBack(*first);
+            }
+            return Insert(pos, std::make_move_iterator(buffer.begin()), std::make_move_iterator(buffer.end()));
+        }
+    }
+
+    // Добавляет элементы диапазона [first, last) в конец вектора
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    constexpr void Append(InputIt first, InputIt last) {
+        if constexpr (IsForwardIteratorV<InputIt>) {
+            Insert(cend(), first, last);
+        } else {
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
         }
-        std::move_backward(const_cast<Iterator>(pos), end(), end() + 1);
-        items_[pos - items_.Get()] = std::move(value);
-        ++size_;
-        return const_cast<Iterator>(pos);
     }
 
-    // "Удаляет" последний элемент вектора. Вектор не должен быть пустым
-    void PopBack() noexcept {
+    // Дописывает в конец до count элементов тривиально копируемого типа, которые
+    // fill(Type* dest, size_t count) записывает прямо в неинициализированную память
+    // за последним элементом и возвращает их число. В отличие от Resize, элементы
+    // не инициализируются заранее, а в отличие от PushBack — не копируются по одному
+    template <typename Fill>
+    size_t AppendUninitialized(size_t count, Fill fill) {
+        static_assert(std::is_trivially_copyable_v<Type>, "AppendUninitialized requires trivially copyable elements");
+        if (count > GetCapacity() - size_) {
+            CheckAppendable(count);
+            ResizeCapacity(GrowCapacity(size_ + count));
+        }
+        const size_t written = fill(end(), count);
+        assert(written <= count);
+        size_ += written;
+        return written;
+    }
+
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    constexpr void PopBack() noexcept {
         assert(size_ > 0);
         --size_;
+        std::destroy_at(end());
     }
 
     // Удаляет элемент вектора в указанной позиции
-    Iterator Erase(ConstIterator pos) {
+    constexpr Iterator Erase(ConstIterator pos) {
         assert(pos >= begin() && pos < end());
         assert(!IsEmpty());
         Iterator new_pos = begin() + (pos - cbegin());
-        std::move(new_pos + 1, end(), new_pos);
-        --size_;
+        ReportStorage(GetCapacity(), GetCapacity(), end() - new_pos - 1);
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            std::destroy_at(new_pos);
+            RelocateShift(new_pos + 1, end(), -1);
+            --size_;
+        } else {
+            std::move(new_pos + 1, end(), new_pos);
+            PopBack();
+        }
         return new_pos;
     }
 
-    void Reserve(const size_t new_capacity) {
-        if (new_capacity > capacity_) {
-            ArrayPtr<Type> new_items(new_capacity);
-            std::copy(begin(), end(), new_items.Get());
-            items_.swap(new_items);
-            capacity_ = new_capacity;
+    // Удаляет элементы диапазона [first, last), сдвигая хвост один раз.
+    // Возвращает итератор на элемент, следовавший за удалёнными
+    constexpr Iterator Erase(ConstIterator first, ConstIterator last) {
+        assert(first >= begin() && first <= last && last <= end());
+        const Iterator new_first = begin() + (first - cbegin());
+        const Iterator new_last = begin() + (last - cbegin());
+        const size_t count = new_last - new_first;
+        ReportStorage(GetCapacity(), GetCapacity(), end() - new_last);
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            std::destroy(new_first, new_last);
+            RelocateShift(new_last, end(), -static_cast<std::ptrdiff_t>(count));
+        } else {
+            std::move(new_last, end(), new_first);
+            std::destroy(end() - count, end());
+        }
+        size_ -= count;
+        return new_first;
+    }
+
+    constexpr void Reserve(const size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            ResizeCapacity(new_capacity);
+        }
+    }
+
+    // Уменьшает вместимость до размера вектора, возвращая неиспользуемую память.
+    // Для пустого вектора память освобождается полностью
+    constexpr void ShrinkToFit() {
+        if (GetCapacity() > size_) {
+            ResizeCapacity(size_);
         }
     }
 
     // Возвращает количество элементов в массиве
-    size_t GetSize() const noexcept {
+    constexpr size_t GetSize() const noexcept {
         return size_;
     }
 
     // Возвращает вместимость массива
-    size_t GetCapacity() const noexcept {
-        return capacity_;
+    constexpr size_t GetCapacity() const noexcept {
+        return items_.GetSize();
+    }
+
+    // Возвращает наибольший размер, который допускает аллокатор
+    constexpr size_t GetMaxSize() const noexcept {
+        return AllocTraits::max_size(items_.GetAllocator());
+    }
+
+    // Возвращает аллокатор вектора
+    constexpr const Allocator& GetAllocator() const noexcept {
+        return items_.GetAllocator();
     }
 
     // Сообщает, пустой ли массив
-    bool IsEmpty() const noexcept {
+    constexpr bool IsEmpty() const noexcept {
         return size_ == 0;
     }
 
     // Возвращает константную ссылку на элемент с индексом index
     // Выбрасывает исключение std::out_of_range, если index >= size
-    Type& At(size_t index) {
+    constexpr Type& At(size_t index) {
         if (index >= size_) {
             throw std::out_of_range("");
         }
@@ -231,135 +404,334 @@ public:
 
     // Возвращает константную ссылку на элемент с индексом index
     // Выбрасывает исключение std::out_of_range, если index >= size
-    const Type& At(size_t index) const {
+    constexpr const Type& At(size_t index) const {
         if (index >= size_) {
             throw std::out_of_range("");
         }
         return items_[index];
     }
 
-    // Обнуляет размер массива, не изменяя его вместимость
-    void Clear() noexcept {
+    // Разрушает все элементы, не изменяя вместимость массива
+    constexpr void Clear() noexcept {
+        std::destroy(begin(), end());
         size_ = 0;
     }
 
     // Изменяет размер массива.
     // При увеличении размера новые элементы получают значение по умолчанию для типа Type
-    void Resize(size_t new_size) {
+    constexpr void Resize(size_t new_size) {
         if (new_size <= size_) {
+            std::destroy(begin() + new_size, end());
             size_ = new_size;
             return;
         }
-        if (new_size < capacity_) {
-            for (size_t i = size_; i < new_size; ++i) {
-                items_[i] = Type();
-            }
-            size_ = new_size;
-            return;
-        }
-        else {
-            size_t new_capacity =  2 * new_size;
-            ArrayPtr<Type> new_items(new_capacity);
-            std::move(begin(), end(), new_items.Get());
-            items_.swap(new_items);
-            size_ = new_size;
-            capacity_ = new_capacity;
-            return;
+        if (new_size > GetCapacity()) {
+            ResizeCapacity(GrowCapacity(new_size));
         }
+        UninitializedValueConstructN(end(), new_size - size_);
+        size_ = new_size;
     }
 
     // Обменивает значение с другим вектором
-    void swap(SimpleVector& other) noexcept {
+    constexpr void swap(SimpleVector& other) noexcept {
         items_.swap(other.items_);
         std::swap(size_, other.size_);
-        std::swap(capacity_, other.capacity_);
     }
 
     // Возвращает итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
-    Iterator begin() noexcept {
+    constexpr Iterator begin() noexcept {
         return items_.Get();
     }
 
     // Возвращает итератор на элемент, следующий за последним
     // Для пустого массива может быть равен (или не равен) nullptr
-    Iterator end() noexcept {
+    constexpr Iterator end() noexcept {
         return items_.Get() + size_;
     }
 
     // Возвращает константный итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator begin() const noexcept {
+    constexpr ConstIterator begin() const noexcept {
         return items_.Get();
     }
 
     // Возвращает итератор на элемент, следующий за последним
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator end() const noexcept {
+    constexpr ConstIterator end() const noexcept {
         return items_.Get() + size_;
     }
 
     // Возвращает константный итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator cbegin() const noexcept {
+    constexpr ConstIterator cbegin() const noexcept {
         return items_.Get();
 
     }
 
     // Возвращает итератор на элемент, следующий за последним
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator cend() const noexcept {
+    constexpr ConstIterator cend() const noexcept {
         return items_.Get() + size_;
     }
 
+#ifdef SIMPLE_VECTOR_STATS
+    // Возвращает статистику всех векторов этого типа
+    static SimpleVectorStatsSnapshot GetStats() {
+        return Stats().GetSnapshot();
+    }
+#endif
+
 private:
-void ResizeCapacity(size_t new_capacity) {
-        ArrayPtr<Type> tmp_data(new_capacity);
-        std::move(std::make_move_iterator(begin()),
-                  std::make_move_iterator(end()), &tmp_data[0]);
-        items_ = std::move(tmp_data);
-        capacity_ = new_capacity;
+    // Буфер можно забрать при перемещающем присваивании, не сравнивая аллокаторы:
+    // они всегда равны, либо обмен буферами обменивает и их, как требует propagate_on_container_move_assignment
+    static constexpr bool STEALS_ON_MOVE = AllocTraits::is_always_equal::value
+                                           || (AllocTraits::propagate_on_container_move_assignment::value
+                                               && AllocTraits::propagate_on_container_swap::value);
+
+#ifdef SIMPLE_VECTOR_STATS
+    static SimpleVectorStats& Stats() {
+        static SimpleVectorStats& stats = SimpleVectorStatsRegistry::Instance().Register(typeid(SimpleVector));
+        return stats;
+    }
+#endif
+
+    // Единственная точка учёта статистики: буфер меняет вместимость с old_capacity
+    // на new_capacity и/или relocated элементов переносятся либо сдвигаются.
+    // Без SIMPLE_VECTOR_STATS функция пустая и ничего не стоит, на этапе компиляции учёт не ведётся
+    constexpr void ReportStorage([[maybe_unused]] size_t old_capacity, [[maybe_unused]] size_t new_capacity,
+                                 [[maybe_unused]] size_t relocated) const {
+#ifdef SIMPLE_VECTOR_STATS
+        if (!std::is_constant_evaluated()) {
+            Stats().Record(old_capacity, new_capacity, size_, relocated, sizeof(Type));
+        }
+#endif
+    }
+
+    // Выбрасывает std::length_error, если к size_ нельзя добавить ещё count элементов.
+    // Сравнение с остатком не переполняется, поэтому огромный count не превратится
+    // в маленький размер буфера
+    constexpr void CheckAppendable(size_t count) const {
+        if (count > GetMaxSize() || size_ > GetMaxSize() - count) {
+            throw std::length_error("SimpleVector size exceeds GetMaxSize()");
+        }
     }
 
-ItemsPtr ReallocateCopy(size_t new_capacity) const {
-        ItemsPtr new_items(new_capacity);  // может бросить исключение
-        size_t copy_size = std::min(new_capacity, size_);
-        std::copy(items_.Get(), items_.Get() + copy_size, new_items.Get());  // может бросить исключение
-        return ItemsPtr(new_items.Release());
+    // Вместимость, до которой нужно вырасти, чтобы вместить required элементов
+    constexpr size_t GrowCapacity(size_t required) const noexcept {
+        return GrowthPolicy::NextCapacity(GetCapacity(), required, sizeof(Type));
     }
 
-    ArrayPtr<Type> items_{};
+    // Переносит элементы в новый буфер вместимостью new_capacity.
+    // Сырая память ArrayPtr позволяет не конструировать лишние ячейки,
+    // а тривиально перемещаемые элементы переносятся через realloc. Элементы, перемещение
+    // которых может бросить исключение, копируются, чтобы при исключении вектор не изменился
+    constexpr void ResizeCapacity(size_t new_capacity) {
+        ReportStorage(GetCapacity(), new_capacity, size_);
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            items_.Reallocate(new_capacity);
+        } else {
+            ItemsPtr new_items(new_capacity, items_.GetAllocator());
+            UninitializedMoveIfNoexcept(begin(), end(), new_items.Get());
+            std::destroy(begin(), end());
+            items_.swap(new_items);
+        }
+    }
+
+    // Присваивает count элементов, начиная с source, поверх имеющихся без выделения памяти:
+    // общая часть — присваиванием, остаток — конструированием. Вместимости должно хватать
+    template <typename It>
+    constexpr void AssignInPlace(It source, size_t count) {
+        const size_t common = std::min(size_, count);
+        std::copy_n(source, common, begin());
+        if (count < size_) {
+            std::destroy(begin() + count, end());
+        } else {
+            UninitializedCopy(source + common, source + count, end());
+        }
+        size_ = count;
+    }
+
+    // Создаёт элемент из args в позиции dist.
+    // Если элемент добавляется в конец и место есть, он конструируется сразу на месте.
+    // Иначе аргументы могут ссылаться на элементы, которые будут сдвинуты или перенесены,
+    // поэтому элемент сначала создаётся в новом буфере (при переполнении) или во временном
+    // объекте, и только потом старые элементы трогаются
+    template <typename... Args>
+    constexpr Iterator EmplaceAt(size_t dist, Args&&... args) {
+        if (dist == size_ && size_ < GetCapacity()) {
+            std::construct_at(end(), std::forward<Args>(args)...);
+            ++size_;
+            return end() - 1;
+        }
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            // Буфер можно расширить через realloc и сдвинуть хвост memmove,
+            // а готовый элемент перенести в освободившуюся ячейку побайтово.
+            // Объединение даёт место под элемент без его конструирования и годится для constexpr
+            union Slot {
+                constexpr Slot() noexcept {
+                }
+                constexpr ~Slot() {
+                }
+                Type value;
+            } slot;
+            Type* const tmp = std::construct_at(&slot.value, std::forward<Args>(args)...);
+            if (size_ == GetCapacity()) {
+                try {
+                    ResizeCapacity(GrowCapacity(size_ + 1));
+                } catch (...) {
+                    std::destroy_at(tmp);
+                    throw;
+                }
+            }
+            const Iterator new_pos = begin() + dist;
+            ReportStorage(GetCapacity(), GetCapacity(), size_ - dist);
+            RelocateShift(new_pos, end(), 1);
+            UninitializedRelocate(tmp, tmp + 1, new_pos);
+            ++size_;
+            return new_pos;
+        } else {
+            if (size_ == GetCapacity()) {
+                ItemsPtr new_items(GrowCapacity(size_ + 1), items_.GetAllocator());
+                std::construct_at(new_items.Get() + dist, std::forward<Args>(args)...);
+                RelocateAround(dist, 1, new_items);
+                return begin() + dist;
+            }
+            const Iterator new_pos = begin() + dist;
+            Type tmp(std::forward<Args>(args)...);
+            ReportStorage(GetCapacity(), GetCapacity(), size_ - dist);
+            std::construct_at(end(), std::move(*(end() - 1)));
+            ++size_;
+            std::move_backward(new_pos, end() - 2, end() - 1);
+            *new_pos = std::move(tmp);
+            return new_pos;
+        }
+    }
+
+    // Вставляет count элементов в позицию dist. construct(dest) должен создать их
+    // в неинициализированной памяти dest и при исключении сам разрушить созданное.
+    // Если места не хватает, память выделяется один раз; иначе хвост сдвигается один раз
+    template <typename Construct>
+    constexpr Iterator InsertN(size_t dist, size_t count, Construct construct) {
+        if (count == 0) {
+            return begin() + dist;
+        }
+        CheckAppendable(count);
+        const size_t required = size_ + count;
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            if (required > GetCapacity()) {
+                ResizeCapacity(GrowCapacity(required));
+            }
+        } else if (required > GetCapacity() || !std::is_nothrow_move_constructible_v<Type>) {
+            // Сдвиг элементов, перемещение которых может выбросить исключение,
+            // оставил бы в векторе дыру, поэтому такие элементы переносятся в новый буфер
+            ItemsPtr new_items(required > GetCapacity() ? GrowCapacity(required) : GetCapacity(),
+                               items_.GetAllocator());
+            construct(new_items.Get() + dist);
+            RelocateAround(dist, count, new_items);
+            return begin() + dist;
+        }
+        ReportStorage(GetCapacity(), GetCapacity(), size_ - dist);
+        OpenGap(dist, count);
+        try {
+            construct(begin() + dist);
+        } catch (...) {
+            CloseGap(dist, count);
+            throw;
+        }
+        size_ += count;
+        return begin() + dist;
+    }
+
+    // Сдвигает хвост [dist, size) на count позиций вправо, оставляя на его месте
+    // неинициализированную память. Вместимости должно хватать
+    constexpr void OpenGap(size_t dist, size_t count) noexcept {
+        const Iterator pos = begin() + dist;
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            RelocateShift(pos, end(), static_cast<std::ptrdiff_t>(count));
+        } else {
+            for (Iterator it = end(); it != pos;) {
+                --it;
+                std::construct_at(it + count, std::move(*it));
+                std::destroy_at(it);
+            }
+        }
+    }
+
+    // Возвращает хвост, сдвинутый OpenGap, на место
+    constexpr void CloseGap(size_t dist, size_t count) noexcept {
+        const Iterator pos = begin() + dist;
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            RelocateShift(pos + count, end() + count, -static_cast<std::ptrdiff_t>(count));
+        } else {
+            for (Iterator it = pos + count; it != end() + count; ++it) {
+                std::construct_at(it - count, std::move(*it));
+                std::destroy_at(it);
+            }
+        }
+    }
+
+    // Переносит элементы в new_items, оставляя свободными count ячеек начиная с dist,
+    // в которых уже сконструированы вставляемые элементы. Как и в ResizeCapacity, элементы
+    // с бросающим перемещением копируются, и при исключении вектор не меняется
+    constexpr void RelocateAround(size_t dist, size_t count, ItemsPtr& new_items) {
+        Type* const new_data = new_items.Get();
+        try {
+            UninitializedMoveIfNoexcept(begin(), begin() + dist, new_data);
+        } catch (...) {
+            std::destroy(new_data + dist, new_data + dist + count);
+            throw;
+        }
+        try {
+            UninitializedMoveIfNoexcept(begin() + dist, end(), new_data + dist + count);
+        } catch (...) {
+            std::destroy(new_data, new_data + dist + count);
+            throw;
+        }
+        ReportStorage(GetCapacity(), new_items.GetSize(), size_);
+        std::destroy(begin(), end());
+        items_.swap(new_items);
+        size_ += count;
+    }
+
+    ItemsPtr items_{};
     size_t size_ = 0;
-    size_t capacity_ = 0;
 };
 
-template <typename Type>
-inline bool operator==(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+constexpr bool operator==(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return (lhs.GetSize() == rhs.GetSize())
-           && std::equal(lhs.begin(), lhs.end(), rhs.begin());  // может бросить исключение
+           && RangesEqual(lhs.begin(), rhs.begin(), lhs.GetSize());  // может бросить исключение
 }
 
-template <typename Type>
-inline bool operator!=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+constexpr bool operator!=(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return !(lhs == rhs);  // может бросить исключение
 }
 
-template <typename Type>
-inline bool operator<(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());  // может бросить исключение
+template <typename Type, typename Allocator, typename GrowthPolicy>
+constexpr bool operator<(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return RangesLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());  // может бросить исключение
 }
 
-template <typename Type>
-inline bool operator<=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+constexpr bool operator<=(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return !(rhs < lhs);  // может бросить исключение
 }
 
-template <typename Type>
-inline bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+constexpr bool operator>(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return rhs < lhs;  // может бросить исключение
 }
 
-template <typename Type>
-inline bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+constexpr bool operator>=(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return rhs <= lhs;  // может бросить исключение
 }
+
+// Индекс первого различающегося элемента. Если один вектор — начало другого,
+// возвращает размер более короткого, для равных векторов — их размер
+template <typename Type, typename Allocator, typename GrowthPolicy>
+constexpr size_t FindFirstMismatch(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return FindFirstMismatch(lhs.begin(), rhs.begin(), std::min(lhs.GetSize(), rhs.GetSize()));  // может бросить исключение
+}
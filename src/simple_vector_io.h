@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "simple_vector.h"
+
+
+// Двоичный формат SimpleVector:
+//     заголовок SerializedVectorHeader (24 байта)
+//     тривиально копируемые элементы — одним блоком байт, size * element_size байт;
+//     остальные — по очереди, каждый как uint64_t длина и столько же байт содержимого.
+// Числа записываются в порядке байт машины, поэтому файлы не переносимы между платформами
+// с разным порядком байт
+
+struct SerializedVectorHeader {
+    static constexpr char MAGIC[8] = {'S', 'V', 'E', 'C', 'B', 'I', 'N', '\0'};
+    static constexpr uint32_t VERSION = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t element_size;  // sizeof элемента для блока байт, 0 — элементы с длиной
+    uint64_t size;
+};
+
+// Запись и чтение содержимого одного элемента нетривиального типа. Для своего типа
+// специализируйте шаблон с двумя функциями:
+//     static void Write(std::string& buffer, const Type& item);  // дописывает байты в buffer
+//     static Type Read(const char* data, size_t bytes);
+template <typename Type, typename = void>
+struct SimpleVectorElementSerializer;
+
+template <typename Char, typename Traits, typename Alloc>
+struct SimpleVectorElementSerializer<std::basic_string<Char, Traits, Alloc>,
+                                     std::enable_if_t<std::is_trivially_copyable_v<Char>>> {
+    using String = std::basic_string<Char, Traits, Alloc>;
+
+    static void Write(std::string& buffer, const String& item) {
+        buffer.append(reinterpret_cast<const char*>(item.data()), item.size() * sizeof(Char));
+    }
+
+    static String Read(const char* data, size_t bytes) {
+        if (bytes % sizeof(Char) != 0) {
+            throw std::runtime_error("SimpleVector: corrupted string element");
+        }
+        String item(bytes / sizeof(Char), Char());
+        std::memcpy(item.data(), data, bytes);
+        return item;
+    }
+};
+
+// Записывает вектор в поток. При ошибке записи выбрасывает std::runtime_error
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void Serialize(std::ostream& out, const SimpleVector<Type, Allocator, GrowthPolicy>& v) {
+    constexpr bool RAW = std::is_trivially_copyable_v<Type>;
+    SerializedVectorHeader header{};
+    std::memcpy(header.magic, SerializedVectorHeader::MAGIC, sizeof(header.magic));
+    header.version = SerializedVectorHeader::VERSION;
+    header.element_size = RAW ? sizeof(Type) : 0;
+    header.size = v.GetSize();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if constexpr (RAW) {
+        out.write(reinterpret_cast<const char*>(v.begin()), static_cast<std::streamsize>(v.GetSize() * sizeof(Type)));
+    } else {
+        std::string buffer;
+        for (const Type& item : v) {
+            buffer.clear();
+            SimpleVectorElementSerializer<Type>::Write(buffer, item);
+            const uint64_t length = buffer.size();
+            out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+    }
+    if (!out) {
+        throw std::runtime_error("SimpleVector: write failed");
+    }
+}
+
+namespace simple_vector_io_detail {
+
+// Сколько байт осталось в потоке до конца. Для потоков без позиционирования
+// (каналы, сокеты) возвращает максимум uint64_t: длина заранее неизвестна
+inline uint64_t RemainingBytes(std::istream& in) {
+    constexpr uint64_t UNKNOWN = std::numeric_limits<uint64_t>::max();
+    const std::istream::pos_type pos = in.tellg();
+    if (pos == std::istream::pos_type(-1)) {
+        return UNKNOWN;
+    }
+    in.seekg(0, std::ios_base::end);
+    const std::istream::pos_type end = in.tellg();
+    in.clear();
+    in.seekg(pos);
+    if (end == std::istream::pos_type(-1) || end < pos) {
+        return UNKNOWN;
+    }
+    return static_cast<uint64_t>(end - pos);
+}
+
+}  // namespace simple_vector_io_detail
+
+// Читает до count тривиально копируемых элементов из потока прямо в хвост v
+// (через AppendUninitialized) и возвращает число прочитанных элементов — меньше count,
+// если поток закончился. Байты незавершённого последнего элемента отбрасываются
+template <typename Type, typename Allocator, typename GrowthPolicy>
+size_t ReadFrom(std::istream& in, SimpleVector<Type, Allocator, GrowthPolicy>& v, size_t count) {
+    return v.AppendUninitialized(count, [&in](Type* dest, size_t n) {
+        in.read(reinterpret_cast<char*>(dest), static_cast<std::streamsize>(n * sizeof(Type)));
+        return static_cast<size_t>(in.gcount()) / sizeof(Type);
+    });
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// То же для файлового дескриптора: read повторяется, пока не прочитано count элементов
+// или не достигнут конец файла. Ошибка чтения выбрасывает std::system_error,
+// при этом уже прочитанные целые элементы остаются в векторе
+template <typename Type, typename Allocator, typename GrowthPolicy>
+size_t ReadFrom(int fd, SimpleVector<Type, Allocator, GrowthPolicy>& v, size_t count) {
+    int error = 0;
+    const size_t read = v.AppendUninitialized(count, [fd, &error](Type* dest, size_t n) {
+        char* const first = reinterpret_cast<char*>(dest);
+        const size_t bytes = n * sizeof(Type);
+        size_t done = 0;
+        while (done < bytes) {
+            const ssize_t result = ::read(fd, first + done, bytes - done);
+            if (result == 0) {
+                break;
+            }
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                error = errno;
+                break;
+            }
+            done += static_cast<size_t>(result);
+        }
+        return done / sizeof(Type);
+    });
+    if (error != 0) {
+        throw std::system_error(error, std::generic_category(), "read");
+    }
+    return read;
+}
+#endif
+
+// Заменяет содержимое v вектором, прочитанным из потока. Блок тривиально копируемых
+// элементов читается прямо в память вектора. Если данные повреждены, обрываются
+// или записаны для другого типа, выбрасывает std::runtime_error, и v остаётся пустым.
+// Размер из заголовка не принимается на веру: он не может превышать GetMaxSize()
+// и число элементов, которое помещается в остаток потока. Если длина потока неизвестна,
+// данные читаются частями, так что память растёт вместе с реально прочитанными байтами
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void Deserialize(std::istream& in, SimpleVector<Type, Allocator, GrowthPolicy>& v) {
+    constexpr bool RAW = std::is_trivially_copyable_v<Type>;
+    // Наименьший размер записи элемента: сам элемент либо поле длины
+    constexpr uint64_t MIN_RECORD_SIZE = RAW ? sizeof(Type) : sizeof(uint64_t);
+    // Порция чтения, когда размер нельзя сверить с длиной потока
+    constexpr uint64_t CHUNK_BYTES = uint64_t{1} << 20;
+
+    v.Clear();
+    SerializedVectorHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, SerializedVectorHeader::MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("SimpleVector: not a serialized vector");
+    }
+    if (header.version != SerializedVectorHeader::VERSION) {
+        throw std::runtime_error("SimpleVector: unsupported format version " + std::to_string(header.version));
+    }
+    if (header.element_size != (RAW ? sizeof(Type) : 0)) {
+        throw std::runtime_error("SimpleVector: serialized elements have size " + std::to_string(header.element_size));
+    }
+    if (header.size > v.GetMaxSize()) {
+        throw std::runtime_error("SimpleVector: serialized size " + std::to_string(header.size) + " is too large");
+    }
+    const uint64_t remaining = simple_vector_io_detail::RemainingBytes(in);
+    if (header.size > remaining / MIN_RECORD_SIZE) {
+        throw std::runtime_error("SimpleVector: serialized data is truncated");
+    }
+
+    try {
+        if constexpr (RAW) {
+            const uint64_t chunk = remaining == std::numeric_limits<uint64_t>::max()
+                                       ? std::max<uint64_t>(CHUNK_BYTES / MIN_RECORD_SIZE, 1)
+                                       : header.size;
+            while (v.GetSize() < header.size) {
+                const size_t count = static_cast<size_t>(std::min<uint64_t>(chunk, header.size - v.GetSize()));
+                if (ReadFrom(in, v, count) != count) {
+                    throw std::runtime_error("SimpleVector: serialized data is truncated");
+                }
+            }
+        } else {
+            std::string buffer;
+            for (uint64_t i = 0; i < header.size; ++i) {
+                uint64_t length = 0;
+                if (!in.read(reinterpret_cast<char*>(&length), sizeof(length))) {
+                    throw std::runtime_error("SimpleVector: serialized data is truncated");
+                }
+                // Длина элемента тоже из файла: содержимое читается частями
+                buffer.clear();
+                while (buffer.size() < length) {
+                    const size_t offset = buffer.size();
+                    const size_t part = static_cast<size_t>(std::min<uint64_t>(length - offset, CHUNK_BYTES));
+                    buffer.resize(offset + part);
+                    if (!in.read(buffer.data() + offset, static_cast<std::streamsize>(part))) {
+                        throw std::runtime_error("SimpleVector: serialized data is truncated");
+                    }
+                }
+                v.PushBack(SimpleVectorElementSerializer<Type>::Read(buffer.data(), buffer.size()));
+            }
+        }
+    } catch (...) {
+        v.Clear();
+        throw;
+    }
+}
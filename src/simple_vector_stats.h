@@ -0,0 +1,166 @@
+#pragma once
+
+// Статистика выделений и переносов элементов SimpleVector.
+// Включается макросом SIMPLE_VECTOR_STATS; без него SimpleVector не подключает
+// этот файл, а точка учёта статистики компилируется в пустую функцию
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+#include <cxxabi.h>
+#endif
+
+// Снимок статистики одного типа вектора
+struct SimpleVectorStatsSnapshot {
+    std::string type_name;
+    size_t allocations = 0;          // сколько раз выделялся буфер
+    size_t reallocations = 0;        // из них — замена уже существующего буфера (рост или сжатие)
+    size_t bytes_allocated = 0;      // суммарный объём выделенных буферов
+    size_t elements_relocated = 0;   // элементы, перенесённые при росте и сдвинутые Insert/Erase
+    size_t peak_capacity = 0;        // наибольшая вместимость одного вектора
+    size_t wasted_capacity = 0;      // неиспользованные ячейки буферов на момент их освобождения
+};
+
+// Счётчики одного типа вектора. Обновляются атомарно, поэтому векторы одного типа
+// можно использовать из разных потоков
+class SimpleVectorStats {
+public:
+    explicit SimpleVectorStats(std::string type_name)
+        : type_name_(std::move(type_name)) {
+    }
+
+    // Буфер сменил вместимость с old_capacity на new_capacity (в элементах по element_size байт),
+    // в нём было size элементов, из них relocated перенесено или сдвинуто
+    void Record(size_t old_capacity, size_t new_capacity, size_t size, size_t relocated, size_t element_size) noexcept {
+        if (new_capacity != old_capacity) {
+            if (new_capacity != 0) {
+                allocations_.fetch_add(1, std::memory_order_relaxed);
+                bytes_allocated_.fetch_add(new_capacity * element_size, std::memory_order_relaxed);
+                if (old_capacity != 0) {
+                    reallocations_.fetch_add(1, std::memory_order_relaxed);
+                }
+                size_t peak = peak_capacity_.load(std::memory_order_relaxed);
+                while (new_capacity > peak
+                       && !peak_capacity_.compare_exchange_weak(peak, new_capacity, std::memory_order_relaxed)) {
+                }
+            }
+            if (old_capacity > size) {
+                wasted_capacity_.fetch_add(old_capacity - size, std::memory_order_relaxed);
+            }
+        }
+        if (relocated != 0) {
+            elements_relocated_.fetch_add(relocated, std::memory_order_relaxed);
+        }
+    }
+
+    SimpleVectorStatsSnapshot GetSnapshot() const {
+        SimpleVectorStatsSnapshot snapshot;
+        snapshot.type_name = type_name_;
+        snapshot.allocations = allocations_.load(std::memory_order_relaxed);
+        snapshot.reallocations = reallocations_.load(std::memory_order_relaxed);
+        snapshot.bytes_allocated = bytes_allocated_.load(std::memory_order_relaxed);
+        snapshot.elements_relocated = elements_relocated_.load(std::memory_order_relaxed);
+        snapshot.peak_capacity = peak_capacity_.load(std::memory_order_relaxed);
+        snapshot.wasted_capacity = wasted_capacity_.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    void Reset() noexcept {
+        allocations_ = 0;
+        reallocations_ = 0;
+        bytes_allocated_ = 0;
+        elements_relocated_ = 0;
+        peak_capacity_ = 0;
+        wasted_capacity_ = 0;
+    }
+
+private:
+    std::string type_name_;
+    std::atomic<size_t> allocations_{0};
+    std::atomic<size_t> reallocations_{0};
+    std::atomic<size_t> bytes_allocated_{0};
+    std::atomic<size_t> elements_relocated_{0};
+    std::atomic<size_t> peak_capacity_{0};
+    std::atomic<size_t> wasted_capacity_{0};
+};
+
+// Реестр статистики всех типов векторов, создавших хотя бы один буфер
+class SimpleVectorStatsRegistry {
+public:
+    static SimpleVectorStatsRegistry& Instance() {
+        static SimpleVectorStatsRegistry registry;
+        return registry;
+    }
+
+    SimpleVectorStats& Register(const std::type_info& type) {
+        std::lock_guard lock(mutex_);
+        stats_.push_back(std::make_unique<SimpleVectorStats>(Demangle(type.name())));
+        return *stats_.back();
+    }
+
+    std::vector<SimpleVectorStatsSnapshot> GetSnapshots() const {
+        std::lock_guard lock(mutex_);
+        std::vector<SimpleVectorStatsSnapshot> result;
+        result.reserve(stats_.size());
+        for (const auto& stats : stats_) {
+            result.push_back(stats->GetSnapshot());
+        }
+        return result;
+    }
+
+    void Reset() {
+        std::lock_guard lock(mutex_);
+        for (const auto& stats : stats_) {
+            stats->Reset();
+        }
+    }
+
+private:
+    static std::string Demangle(const char* name) {
+#if defined(__GNUC__) || defined(__clang__)
+        int status = 0;
+        std::unique_ptr<char, void (*)(void*)> demangled(
+                abi::__cxa_demangle(name, nullptr, nullptr, &status), std::free);
+        if (status == 0 && demangled) {
+            return demangled.get();
+        }
+#endif
+        return name;
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<SimpleVectorStats>> stats_;
+};
+
+// Возвращает статистику по всем типам векторов
+inline std::vector<SimpleVectorStatsSnapshot> GetSimpleVectorStats() {
+    return SimpleVectorStatsRegistry::Instance().GetSnapshots();
+}
+
+// Обнуляет статистику всех типов векторов
+inline void ResetSimpleVectorStats() {
+    SimpleVectorStatsRegistry::Instance().Reset();
+}
+
+// Печатает статистику всех типов векторов, по строке на тип
+inline void DumpSimpleVectorStats(std::ostream& out) {
+    for (const auto& stats : GetSimpleVectorStats()) {
+        out << stats.type_name
+            << ": allocations=" << stats.allocations
+            << " reallocations=" << stats.reallocations
+            << " bytes_allocated=" << stats.bytes_allocated
+            << " elements_relocated=" << stats.elements_relocated
+            << " peak_capacity=" << stats.peak_capacity
+            << " wasted_capacity=" << stats.wasted_capacity
+            << '\n';
+    }
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "simd_compare.h"
+
+
+template <typename Element>
+class BasicSimpleVectorView;
+
+namespace simple_vector_view_detail {
+
+template <typename Type>
+inline constexpr bool IS_VIEW = false;
+
+template <typename Element>
+inline constexpr bool IS_VIEW<BasicSimpleVectorView<Element>> = true;
+
+// Указатель Pointer можно хранить как Element*: отличаться может только const.
+// Указатель на производный класс не подходит — шаг по массиву у него другой
+template <typename Pointer, typename Element>
+concept CompatiblePointer = std::is_pointer_v<Pointer>
+                            && std::is_convertible_v<std::remove_pointer_t<Pointer> (*)[], Element (*)[]>;
+
+// SimpleVector, SmallSimpleVector, StaticVector и другие контейнеры этой библиотеки,
+// у которых begin() — указатель на непрерывные элементы, а размер — GetSize()
+template <typename Container, typename Element>
+concept SimpleContiguous = !IS_VIEW<std::remove_cv_t<Container>> && requires(Container& container) {
+    { container.GetSize() } -> std::convertible_to<size_t>;
+} && CompatiblePointer<decltype(std::declval<Container&>().begin()), Element>;
+
+// std::vector, std::array, std::string, C-массивы: std::data и std::size
+template <typename Container, typename Element>
+concept StdContiguous = requires(Container& container) {
+    { std::size(container) } -> std::convertible_to<size_t>;
+} && CompatiblePointer<decltype(std::data(std::declval<Container&>())), Element>;
+
+// Элементы срезов одного типа, возможно с разной константностью
+template <typename Lhs, typename Rhs>
+concept SameElement = std::is_same_v<std::remove_const_t<Lhs>, std::remove_const_t<Rhs>>;
+
+}  // namespace simple_vector_view_detail
+
+// Невладеющий срез непрерывного массива элементов Element: указатель и длина.
+// Копируется за O(1), поэтому его передают по значению вместо копии вектора или пары
+// итераторов. Неявно создаётся из SimpleVector и родственных контейнеров, std::vector,
+// std::array и C-массивов. Срез действителен, пока жив контейнер и его элементы
+// не перевыделены. Используйте псевдонимы SimpleVectorView (только чтение)
+// и MutableSimpleVectorView (элементы можно менять, размер — нет)
+template <typename Element>
+class BasicSimpleVectorView {
+public:
+    using Iterator = Element*;
+    using ConstIterator = Element*;
+
+    constexpr BasicSimpleVectorView() noexcept = default;
+
+    constexpr BasicSimpleVectorView(Element* data, size_t size) noexcept
+        : data_(data),
+          size_(size) {
+    }
+
+    constexpr BasicSimpleVectorView(Element* first, Element* last) noexcept
+        : data_(first),
+          size_(static_cast<size_t>(last - first)) {
+    }
+
+    // Изменяемый срез преобразуется в срез только для чтения
+    template <typename Other>
+        requires (!std::is_same_v<Other, Element>) && simple_vector_view_detail::CompatiblePointer<Other*, Element>
+    constexpr BasicSimpleVectorView(BasicSimpleVectorView<Other> other) noexcept
+        : data_(other.data()),
+          size_(other.GetSize()) {
+    }
+
+    // Срез всего контейнера
+    template <typename Container>
+        requires simple_vector_view_detail::SimpleContiguous<Container, Element>
+    constexpr BasicSimpleVectorView(Container& container) noexcept(noexcept(container.begin()))
+        : data_(container.begin()),
+          size_(container.GetSize()) {
+    }
+
+    template <typename Container>
+        requires simple_vector_view_detail::StdContiguous<Container, Element>
+                 && (!simple_vector_view_detail::SimpleContiguous<Container, Element>)
+    constexpr BasicSimpleVectorView(Container& container) noexcept
+        : data_(std::data(container)),
+          size_(std::size(container)) {
+    }
+
+    constexpr Element* data() const noexcept {
+        return data_;
+    }
+
+    constexpr size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    constexpr bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    constexpr Element& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    constexpr Element& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("");
+        }
+        return data_[index];
+    }
+
+    // Срез из count элементов начиная с offset.
+    // Выбрасывает исключение std::out_of_range, если он выходит за границы
+    constexpr BasicSimpleVectorView Subview(size_t offset, size_t count) const {
+        if (offset > size_ || count > size_ - offset) {
+            throw std::out_of_range("");
+        }
+        return {data_ + offset, count};
+    }
+
+    // Срез от offset до конца
+    constexpr BasicSimpleVectorView Subview(size_t offset) const {
+        if (offset > size_) {
+            throw std::out_of_range("");
+        }
+        return {data_ + offset, size_ - offset};
+    }
+
+    // Первые count элементов
+    constexpr BasicSimpleVectorView First(size_t count) const {
+        return Subview(0, count);
+    }
+
+    // Последние count элементов
+    constexpr BasicSimpleVectorView Last(size_t count) const {
+        if (count > size_) {
+            throw std::out_of_range("");
+        }
+        return {data_ + (size_ - count), count};
+    }
+
+    constexpr Element* begin() const noexcept {
+        return data_;
+    }
+
+    constexpr Element* end() const noexcept {
+        return data_ + size_;
+    }
+
+    constexpr Element* cbegin() const noexcept {
+        return data_;
+    }
+
+    constexpr Element* cend() const noexcept {
+        return data_ + size_;
+    }
+
+private:
+    Element* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+template <typename Type>
+using SimpleVectorView = BasicSimpleVectorView<const Type>;
+
+template <typename Type>
+using MutableSimpleVectorView = BasicSimpleVectorView<Type>;
+
+// Сравнения срезов с элементами одного типа, в том числе изменяемого среза с константным
+template <typename Lhs, typename Rhs>
+    requires simple_vector_view_detail::SameElement<Lhs, Rhs>
+constexpr bool operator==(BasicSimpleVectorView<Lhs> lhs, BasicSimpleVectorView<Rhs> rhs) {
+    using Type = std::remove_const_t<Lhs>;
+    return lhs.GetSize() == rhs.GetSize()
+           && RangesEqual<Type>(lhs.data(), rhs.data(), lhs.GetSize());  // может бросить исключение
+}
+
+template <typename Lhs, typename Rhs>
+    requires simple_vector_view_detail::SameElement<Lhs, Rhs>
+constexpr bool operator!=(BasicSimpleVectorView<Lhs> lhs, BasicSimpleVectorView<Rhs> rhs) {
+    return !(lhs == rhs);  // может бросить исключение
+}
+
+template <typename Lhs, typename Rhs>
+    requires simple_vector_view_detail::SameElement<Lhs, Rhs>
+constexpr bool operator<(BasicSimpleVectorView<Lhs> lhs, BasicSimpleVectorView<Rhs> rhs) {
+    using Type = std::remove_const_t<Lhs>;
+    return RangesLess<Type>(lhs.data(), lhs.GetSize(), rhs.data(), rhs.GetSize());  // может бросить исключение
+}
+
+template <typename Lhs, typename Rhs>
+    requires simple_vector_view_detail::SameElement<Lhs, Rhs>
+constexpr bool operator<=(BasicSimpleVectorView<Lhs> lhs, BasicSimpleVectorView<Rhs> rhs) {
+    return !(rhs < lhs);  // может бросить исключение
+}
+
+template <typename Lhs, typename Rhs>
+    requires simple_vector_view_detail::SameElement<Lhs, Rhs>
+constexpr bool operator>(BasicSimpleVectorView<Lhs> lhs, BasicSimpleVectorView<Rhs> rhs) {
+    return rhs < lhs;  // может бросить исключение
+}
+
+template <typename Lhs, typename Rhs>
+    requires simple_vector_view_detail::SameElement<Lhs, Rhs>
+constexpr bool operator>=(BasicSimpleVectorView<Lhs> lhs, BasicSimpleVectorView<Rhs> rhs) {
+    return rhs <= lhs;  // может бросить исключение
+}
@@ -0,0 +1,437 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "allocator.h"
+#include "array_ptr.h"
+#include "relocation.h"
+#include "simd_compare.h"
+#include "simple_vector.h"
+
+
+// Вектор с тем же интерфейсом, что и SimpleVector, но хранящий до N элементов
+// прямо внутри объекта. Куча используется только когда элементов становится больше N
+template <typename Type, size_t N, typename Allocator = MallocAllocator<Type>>
+class SmallSimpleVector {
+    static_assert(N > 0, "Inline capacity must be positive");
+
+public:
+    using ItemsPtr = ArrayPtr<Type, Allocator>;
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+    using AllocatorType = Allocator;
+
+    SmallSimpleVector() noexcept = default;
+
+    // Создаёт пустой вектор, который при переполнении берёт память у аллокатора alloc
+    explicit SmallSimpleVector(const Allocator& alloc) noexcept
+        : heap_(alloc)
+    {
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    explicit SmallSimpleVector(size_t size, const Allocator& alloc = Allocator())
+        : heap_(alloc)
+    {
+        Reserve(size);
+        std::uninitialized_value_construct_n(begin(), size);
+        size_ = size;
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    SmallSimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator())
+        : heap_(alloc)
+    {
+        Reserve(size);
+        std::uninitialized_fill_n(begin(), size, value);
+        size_ = size;
+    }
+
+    // Создаёт вектор из std::initializer_list
+    SmallSimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator())
+        : heap_(alloc)
+    {
+        Reserve(init.size());
+        std::uninitialized_copy(init.begin(), init.end(), begin());
+        size_ = init.size();
+    }
+
+    // Создаёт пустой вектор и резервирует необходимую память
+    explicit SmallSimpleVector(const ReserveProxyObj& proxyObj, const Allocator& alloc = Allocator())
+        : heap_(alloc)
+    {
+        Reserve(proxyObj.capacity_);
+    }
+
+    SmallSimpleVector(const SmallSimpleVector& other)
+        : heap_(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.GetAllocator()))
+    {
+        Reserve(other.size_);
+        std::uninitialized_copy(other.begin(), other.end(), begin());
+        size_ = other.size_;
+    }
+
+    // Если other хранит элементы в куче, буфер забирается целиком,
+    // иначе элементы по одному переносятся во встроенный буфер
+    SmallSimpleVector(SmallSimpleVector&& other) noexcept(std::is_nothrow_move_constructible_v<Type>)
+        : heap_(other.GetAllocator())
+    {
+        StealFrom(other);
+    }
+
+    ~SmallSimpleVector() {
+        Clear();
+    }
+
+    SmallSimpleVector& operator=(const SmallSimpleVector& rhs) {
+        if (this == &rhs) {
+            return *this;
+        }
+        SmallSimpleVector new_vector(rhs);
+        swap(new_vector);
+        return *this;
+    }
+
+    // Как и SimpleVector, забирает буфер rhs в куче, если аллокаторы всегда равны,
+    // распространяются при перемещении и обмене либо просто равны. Иначе память rhs
+    // нельзя освобождать аллокатором этого вектора, и элементы перемещаются по одному
+    SmallSimpleVector& operator=(SmallSimpleVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<Type>
+                                                                   && STEALS_ON_MOVE) {
+        if (this == &rhs) {
+            return *this;
+        }
+        if (rhs.IsInline() || STEALS_ON_MOVE || GetAllocator() == rhs.GetAllocator()) {
+            Clear();
+            StealFrom(rhs);
+            return *this;
+        }
+        if (rhs.size_ > GetCapacity()) {
+            ItemsPtr new_items(rhs.size_, heap_.GetAllocator());
+            Clear();
+            heap_.swap(new_items);
+        } else {
+            Clear();
+        }
+        UninitializedMove(rhs.begin(), rhs.end(), begin());
+        size_ = rhs.size_;
+        rhs.Clear();
+        return *this;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return begin()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return begin()[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("");
+        }
+        return begin()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("");
+        }
+        return begin()[index];
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceAt(size_, item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceAt(size_, std::move(item));
+    }
+
+    // Создаёт элемент в конце вектора из аргументов args.
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return *EmplaceAt(size_, std::forward<Args>(args)...);
+    }
+
+    // Создаёт элемент из аргументов args в позиции pos.
+    // Возвращает итератор на созданный элемент
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        assert(pos >= begin() && pos <= end());
+        return EmplaceAt(pos - cbegin(), std::forward<Args>(args)...);
+    }
+
+    // Вставляет значение value в позицию pos.
+    // Возвращает итератор на вставленное значение
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        assert(pos >= begin() && pos <= end());
+        return EmplaceAt(pos - cbegin(), value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        assert(pos >= begin() && pos <= end());
+        return EmplaceAt(pos - cbegin(), std::move(value));
+    }
+
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        assert(size_ > 0);
+        --size_;
+        std::destroy_at(end());
+    }
+
+    // Удаляет элемент вектора в указанной позиции
+    Iterator Erase(ConstIterator pos) {
+        assert(pos >= begin() && pos < end());
+        Iterator new_pos = begin() + (pos - cbegin());
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            std::destroy_at(new_pos);
+            RelocateShift(new_pos + 1, end(), -1);
+            --size_;
+        } else {
+            std::move(new_pos + 1, end(), new_pos);
+            PopBack();
+        }
+        return new_pos;
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            ResizeCapacity(new_capacity);
+        }
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость массива
+    size_t GetCapacity() const noexcept {
+        return IsInline() ? N : heap_.GetSize();
+    }
+
+    // Сообщает, хранятся ли элементы во встроенном буфере
+    bool IsInline() const noexcept {
+        return !heap_;
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Возвращает аллокатор, которым выделяется память в куче
+    const Allocator& GetAllocator() const noexcept {
+        return heap_.GetAllocator();
+    }
+
+    // Разрушает все элементы, не изменяя вместимость массива
+    void Clear() noexcept {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    // Изменяет размер массива.
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type
+    void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            std::destroy(begin() + new_size, end());
+            size_ = new_size;
+            return;
+        }
+        if (new_size > GetCapacity()) {
+            ResizeCapacity(std::max(GetCapacity() * 2, new_size));
+        }
+        std::uninitialized_value_construct(end(), begin() + new_size);
+        size_ = new_size;
+    }
+
+    // Обменивает значение с другим вектором. Если оба вектора в куче и буферы можно
+    // передать (см. перемещающее присваивание), обмениваются только указатели,
+    // иначе элементы переносятся через временный вектор
+    void swap(SmallSimpleVector& other) noexcept(std::is_nothrow_move_constructible_v<Type> && STEALS_ON_MOVE) {
+        if (!IsInline() && !other.IsInline() && (STEALS_ON_MOVE || GetAllocator() == other.GetAllocator())) {
+            heap_.swap(other.heap_);
+            std::swap(size_, other.size_);
+            return;
+        }
+        SmallSimpleVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    Iterator begin() noexcept {
+        return IsInline() ? InlineData() : heap_.Get();
+    }
+
+    Iterator end() noexcept {
+        return begin() + size_;
+    }
+
+    ConstIterator begin() const noexcept {
+        return IsInline() ? InlineData() : heap_.Get();
+    }
+
+    ConstIterator end() const noexcept {
+        return begin() + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    // См. SimpleVector::STEALS_ON_MOVE
+    static constexpr bool STEALS_ON_MOVE = AllocTraits::is_always_equal::value
+                                           || (AllocTraits::propagate_on_container_move_assignment::value
+                                               && AllocTraits::propagate_on_container_swap::value);
+
+    Type* InlineData() noexcept {
+        return std::launder(reinterpret_cast<Type*>(inline_));
+    }
+
+    const Type* InlineData() const noexcept {
+        return std::launder(reinterpret_cast<const Type*>(inline_));
+    }
+
+    // Переносит элементы в буфер в куче вместимостью new_capacity. Как и в SimpleVector,
+    // элементы с бросающим перемещением копируются, а старые разрушаются только
+    // после успешного переноса, поэтому при исключении вектор не меняется
+    void ResizeCapacity(size_t new_capacity) {
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            if (!IsInline()) {
+                heap_.Reallocate(new_capacity);
+                return;
+            }
+        }
+        ItemsPtr new_items(new_capacity, heap_.GetAllocator());
+        UninitializedMoveIfNoexcept(begin(), end(), new_items.Get());
+        std::destroy(begin(), end());
+        heap_.swap(new_items);
+    }
+
+    // Забирает элементы other, оставляя его пустым. Вектор должен быть пуст, а буфер
+    // other в куче — совместим с аллокатором этого вектора. Буферы в куче обмениваются,
+    // так что other получает прежний буфер этого вектора
+    void StealFrom(SmallSimpleVector& other) {
+        if (!other.IsInline()) {
+            heap_.swap(other.heap_);
+        } else {
+            UninitializedRelocate(other.begin(), other.end(), begin());
+        }
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    // Переносит элементы в new_items, оставляя свободной ячейку dist, в которой уже
+    // создан новый элемент. Как и в ResizeCapacity, при исключении вектор не меняется
+    void RelocateAround(size_t dist, ItemsPtr& new_items) {
+        Type* const new_data = new_items.Get();
+        try {
+            UninitializedMoveIfNoexcept(begin(), begin() + dist, new_data);
+        } catch (...) {
+            std::destroy_at(new_data + dist);
+            throw;
+        }
+        try {
+            UninitializedMoveIfNoexcept(begin() + dist, end(), new_data + dist + 1);
+        } catch (...) {
+            std::destroy(new_data, new_data + dist + 1);
+            throw;
+        }
+        std::destroy(begin(), end());
+        heap_.swap(new_items);
+        ++size_;
+    }
+
+    // Создаёт элемент из args в позиции dist. При переполнении новый элемент
+    // конструируется в новом буфере до переноса старых, а при сдвиге — во временном
+    // объекте, поэтому args могут ссылаться на элементы самого вектора
+    template <typename... Args>
+    Iterator EmplaceAt(size_t dist, Args&&... args) {
+        if (size_ == GetCapacity()) {
+            ItemsPtr new_items(GetCapacity() * 2, heap_.GetAllocator());
+            Type* const new_data = new_items.Get();
+            new (new_data + dist) Type(std::forward<Args>(args)...);
+            RelocateAround(dist, new_items);
+            return begin() + dist;
+        }
+        const Iterator new_pos = begin() + dist;
+        if (new_pos == end()) {
+            new (end()) Type(std::forward<Args>(args)...);
+        } else if constexpr (IsTriviallyRelocatableV<Type>) {
+            Type tmp(std::forward<Args>(args)...);
+            RelocateShift(new_pos, end(), 1);
+            try {
+                new (new_pos) Type(std::move(tmp));
+            } catch (...) {
+                RelocateShift(new_pos + 1, end() + 1, -1);
+                throw;
+            }
+        } else {
+            Type tmp(std::forward<Args>(args)...);
+            new (end()) Type(std::move(*(end() - 1)));
+            std::move_backward(new_pos, end() - 1, end());
+            *new_pos = std::move(tmp);
+        }
+        ++size_;
+        return new_pos;
+    }
+
+    alignas(Type) unsigned char inline_[N * sizeof(Type)];
+    ItemsPtr heap_{};
+    size_t size_ = 0;
+};
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator==(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return (lhs.GetSize() == rhs.GetSize())
+           && RangesEqual(lhs.begin(), rhs.begin(), lhs.GetSize());  // может бросить исключение
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator!=(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return !(lhs == rhs);  // может бросить исключение
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator<(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return RangesLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());  // может бросить исключение
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator<=(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return !(rhs < lhs);  // может бросить исключение
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator>(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return rhs < lhs;  // может бросить исключение
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator>=(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return rhs <= lhs;  // может бросить исключение
+}
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "simple_vector.h"
+#include "simple_vector_view.h"
+
+
+namespace soa_vector_detail {
+
+using std::get;
+
+// Поле I кортежеподобной записи: std::get для типов стандартной библиотеки
+// или get<I> из пространства имён записи, найденная по ADL
+template <size_t I, typename TupleLike>
+constexpr decltype(auto) GetField(TupleLike&& record) {
+    return get<I>(std::forward<TupleLike>(record));
+}
+
+}  // namespace soa_vector_detail
+
+// Вектор записей из полей Fields..., в котором каждое поле хранится в отдельном
+// непрерывном массиве (structure of arrays). Цикл по одному полю читает только его байты,
+// а не целые записи. Интерфейс повторяет SimpleVector, но позиции задаются индексами,
+// а operator[] возвращает прокси — кортеж ссылок std::tuple<Fields&...>:
+//     auto [id, price] = v[i];     // ссылки на поля записи i
+//     v[i] = std::make_tuple(1, 2.0);
+// Запись для PushBack/Insert — любой кортежеподобный объект, как для структурных привязок:
+// std::tuple, std::pair, std::array или своя структура, для которой специализирован
+// std::tuple_size и рядом с ней, в её пространстве имён, объявлена функция get<I>.
+// Поля берутся неквалифицированным вызовом get<I>, поэтому свой get находится по ADL
+template <typename... Fields>
+class SoAVector {
+    static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+    using Columns = std::tuple<SimpleVector<Fields>...>;
+    using Indices = std::index_sequence_for<Fields...>;
+
+public:
+    using Record = std::tuple<Fields...>;
+    using Reference = std::tuple<Fields&...>;
+    using ConstReference = std::tuple<const Fields&...>;
+
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, Record>;
+
+    static constexpr size_t FIELD_COUNT = sizeof...(Fields);
+
+    SoAVector() noexcept = default;
+
+    // Создаёт вектор из size записей, поля которых инициализированы значением по умолчанию
+    explicit SoAVector(size_t size)
+        : columns_(SimpleVector<Fields>(size)...) {
+    }
+
+    SoAVector(std::initializer_list<Record> init) {
+        Reserve(init.size());
+        for (const Record& record : init) {
+            PushBack(record);
+        }
+    }
+
+    Reference operator[](size_t index) noexcept {
+        assert(index < GetSize());
+        return MakeReference(index, Indices{});
+    }
+
+    ConstReference operator[](size_t index) const noexcept {
+        assert(index < GetSize());
+        return MakeReference(index, Indices{});
+    }
+
+    Reference At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("");
+        }
+        return (*this)[index];
+    }
+
+    ConstReference At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("");
+        }
+        return (*this)[index];
+    }
+
+    // Поле I записи index
+    template <size_t I>
+    FieldType<I>& Get(size_t index) noexcept {
+        assert(index < GetSize());
+        return std::get<I>(columns_)[index];
+    }
+
+    template <size_t I>
+    const FieldType<I>& Get(size_t index) const noexcept {
+        assert(index < GetSize());
+        return std::get<I>(columns_)[index];
+    }
+
+    // Все значения поля I одним непрерывным массивом — циклы по нему компилятор векторизует.
+    // Действителен до изменения ёмкости
+    template <size_t I>
+    MutableSimpleVectorView<FieldType<I>> Field() noexcept {
+        return std::get<I>(columns_);
+    }
+
+    template <size_t I>
+    SimpleVectorView<FieldType<I>> Field() const noexcept {
+        return std::get<I>(columns_);
+    }
+
+    size_t GetSize() const noexcept {
+        return std::get<0>(columns_).GetSize();
+    }
+
+    size_t GetCapacity() const noexcept {
+        return std::get<0>(columns_).GetCapacity();
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Добавляет запись из значений полей. Если конструктор одного из полей
+    // бросает исключение, уже добавленные поля удаляются и вектор не меняется
+    template <typename... Args>
+    Reference EmplaceBack(Args&&... args) {
+        static_assert(sizeof...(Args) == FIELD_COUNT, "EmplaceBack takes one value per field");
+        EmplaceBackImpl(Indices{}, std::forward<Args>(args)...);
+        return (*this)[GetSize() - 1];
+    }
+
+    template <typename TupleLike>
+    void PushBack(TupleLike&& record) {
+        static_assert(std::tuple_size_v<std::remove_cvref_t<TupleLike>> == FIELD_COUNT,
+                      "PushBack takes a record with one value per field");
+        PushBackImpl(std::forward<TupleLike>(record), Indices{});
+    }
+
+    // Вставляет запись перед позицией pos и возвращает pos.
+    // Если исключение бросает одно из полей, вектор не меняется
+    template <typename TupleLike>
+    size_t Insert(size_t pos, TupleLike&& record) {
+        assert(pos <= GetSize());
+        InsertImpl(pos, std::forward<TupleLike>(record), Indices{});
+        return pos;
+    }
+
+    void PopBack() noexcept {
+        assert(!IsEmpty());
+        std::apply([](auto&... columns) {
+            (columns.PopBack(), ...);
+        }, columns_);
+    }
+
+    // Удаляет запись pos и возвращает индекс следующей за ней
+    size_t Erase(size_t pos) {
+        assert(pos < GetSize());
+        return Erase(pos, pos + 1);
+    }
+
+    // Удаляет записи [first, last) и возвращает first
+    size_t Erase(size_t first, size_t last) {
+        assert(first <= last && last <= GetSize());
+        std::apply([first, last](auto&... columns) {
+            (columns.Erase(columns.begin() + first, columns.begin() + last), ...);
+        }, columns_);
+        return first;
+    }
+
+    // Изменяет размер; поля новых записей инициализируются значением по умолчанию.
+    // Если конструктор бросает исключение, размер вектора не меняется
+    void Resize(size_t new_size) {
+        ForEachColumnWithRollback([new_size](auto& column) { column.Resize(new_size); });
+    }
+
+    void Reserve(size_t new_capacity) {
+        std::apply([new_capacity](auto&... columns) {
+            (columns.Reserve(new_capacity), ...);
+        }, columns_);
+    }
+
+    void ShrinkToFit() {
+        std::apply([](auto&... columns) {
+            (columns.ShrinkToFit(), ...);
+        }, columns_);
+    }
+
+    void Clear() noexcept {
+        std::apply([](auto&... columns) {
+            (columns.Clear(), ...);
+        }, columns_);
+    }
+
+    void swap(SoAVector& other) noexcept {
+        SwapColumns(other, Indices{});
+    }
+
+    // Сравнивает столбцы целиком, поэтому для арифметических полей работают SIMD-сравнения SimpleVector
+    friend bool operator==(const SoAVector& lhs, const SoAVector& rhs) {
+        return lhs.columns_ == rhs.columns_;  // может бросить исключение
+    }
+
+private:
+    template <size_t... I>
+    Reference MakeReference(size_t index, std::index_sequence<I...>) noexcept {
+        return Reference(std::get<I>(columns_)[index]...);
+    }
+
+    template <size_t... I>
+    ConstReference MakeReference(size_t index, std::index_sequence<I...>) const noexcept {
+        return ConstReference(std::get<I>(columns_)[index]...);
+    }
+
+    template <size_t... I, typename... Args>
+    void EmplaceBackImpl(std::index_sequence<I...>, Args&&... args) {
+        size_t added = 0;
+        try {
+            ((std::get<I>(columns_).EmplaceBack(std::forward<Args>(args)), ++added), ...);
+        } catch (...) {
+            ((I < added ? std::get<I>(columns_).PopBack() : void()), ...);
+            throw;
+        }
+    }
+
+    template <typename TupleLike, size_t... I>
+    void PushBackImpl(TupleLike&& record, std::index_sequence<I...>) {
+        EmplaceBack(soa_vector_detail::GetField<I>(std::forward<TupleLike>(record))...);
+    }
+
+    template <typename TupleLike, size_t... I>
+    void InsertImpl(size_t pos, TupleLike&& record, std::index_sequence<I...>) {
+        static_assert(std::tuple_size_v<std::remove_cvref_t<TupleLike>> == FIELD_COUNT,
+                      "Insert takes a record with one value per field");
+        size_t inserted = 0;
+        try {
+            ((std::get<I>(columns_).Emplace(std::get<I>(columns_).begin() + pos,
+                                            soa_vector_detail::GetField<I>(std::forward<TupleLike>(record))),
+              ++inserted), ...);
+        } catch (...) {
+            ((I < inserted ? void(std::get<I>(columns_).Erase(std::get<I>(columns_).begin() + pos)) : void()), ...);
+            throw;
+        }
+    }
+
+    // Применяет operation к каждому столбцу; если она бросает исключение,
+    // размер уже изменённых столбцов возвращается к прежнему
+    template <typename Operation>
+    void ForEachColumnWithRollback(Operation operation) {
+        const size_t old_size = GetSize();
+        std::apply([&](auto&... columns) {
+            size_t done = 0;
+            try {
+                ((operation(columns), ++done), ...);
+            } catch (...) {
+                size_t column = 0;
+                ((column++ < done ? columns.Resize(old_size) : void()), ...);
+                throw;
+            }
+        }, columns_);
+    }
+
+    template <size_t... I>
+    void SwapColumns(SoAVector& other, std::index_sequence<I...>) noexcept {
+        (std::get<I>(columns_).swap(std::get<I>(other.columns_)), ...);
+    }
+
+    Columns columns_;
+};
+
+template <typename... Fields>
+inline bool operator!=(const SoAVector<Fields...>& lhs, const SoAVector<Fields...>& rhs) {
+    return !(lhs == rhs);  // может бросить исключение
+}
@@ -0,0 +1,519 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "overflow_policy.h"
+#include "relocation.h"
+#include "simd_compare.h"
+#include "simple_vector.h"
+
+
+// Вектор вместимостью N с интерфейсом SimpleVector, хранящий элементы внутри объекта.
+// Память из кучи не выделяется никогда, поэтому вектор годится для lock-free структур
+// и (с политикой AbortOnOverflow или RejectOnOverflow) для обработчиков сигналов.
+// Что делать, если элементы не помещаются, решает OverflowPolicy из overflow_policy.h.
+// Для тривиально копируемого Type вектор сам тривиально копируем, и его можно переносить
+// memcpy, например через разделяемую память; перемещение такого вектора копирует элементы.
+// Вектор из остальных типов после перемещения пуст
+template <typename Type, size_t N, typename OverflowPolicy = ThrowOnOverflow>
+class StaticVector {
+    static_assert(N > 0, "Capacity must be positive");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+    // EmplaceBack возвращает ссылку на элемент, а при отклоняющей политике — указатель или nullptr
+    using EmplaceResult = std::conditional_t<OverflowPolicy::REJECT, Type*, Type&>;
+
+    StaticVector() noexcept = default;
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию.
+    // Если size > N и политика отклоняет переполнение, вектор остаётся пустым
+    explicit StaticVector(size_t size) {
+        if (Fits(size)) {
+            UninitializedValueConstructN(Data(), size);
+            size_ = size;
+        }
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    StaticVector(size_t size, const Type& value) {
+        if (Fits(size)) {
+            UninitializedFillN(Data(), size, value);
+            size_ = size;
+        }
+    }
+
+    StaticVector(std::initializer_list<Type> init) {
+        if (Fits(init.size())) {
+            UninitializedCopy(init.begin(), init.end(), Data());
+            size_ = init.size();
+        }
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    StaticVector(InputIt first, InputIt last) {
+        Append(first, last);
+    }
+
+    // Копирование и перемещение тривиальны (побайтовы), если тривиальны у Type
+    StaticVector(const StaticVector&) requires std::is_trivially_copy_constructible_v<Type> = default;
+
+    StaticVector(const StaticVector& other) {
+        UninitializedCopy(other.begin(), other.end(), Data());
+        size_ = other.size_;
+    }
+
+    StaticVector(StaticVector&&) requires std::is_trivially_move_constructible_v<Type> = default;
+
+    // Переносит элементы other по одному, оставляя other пустым
+    StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        UninitializedRelocate(other.begin(), other.end(), Data());
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    ~StaticVector() requires std::is_trivially_destructible_v<Type> = default;
+
+    ~StaticVector() {
+        Clear();
+    }
+
+    StaticVector& operator=(const StaticVector&)
+        requires std::is_trivially_copy_assignable_v<Type> && std::is_trivially_copy_constructible_v<Type>
+                 && std::is_trivially_destructible_v<Type>
+    = default;
+
+    // Присваивает элементы rhs поверх имеющихся. Если копирование бросит исключение,
+    // вектор останется корректным, но может содержать лишь часть элементов rhs
+    StaticVector& operator=(const StaticVector& rhs) {
+        if (this != &rhs) {
+            AssignFrom(rhs.begin(), rhs.size_, [](const Type& item) -> const Type& {
+                return item;
+            });
+        }
+        return *this;
+    }
+
+    StaticVector& operator=(StaticVector&&)
+        requires std::is_trivially_move_assignable_v<Type> && std::is_trivially_move_constructible_v<Type>
+                 && std::is_trivially_destructible_v<Type>
+    = default;
+
+    // Перемещает элементы rhs поверх имеющихся, оставляя rhs пустым
+    StaticVector& operator=(StaticVector&& rhs) noexcept(std::is_nothrow_move_assignable_v<Type>
+                                                         && std::is_nothrow_move_constructible_v<Type>) {
+        if (this != &rhs) {
+            AssignFrom(rhs.begin(), rhs.size_, [](Type& item) -> Type&& {
+                return std::move(item);
+            });
+            rhs.Clear();
+        }
+        return *this;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Data()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return Data()[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("");
+        }
+        return Data()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("");
+        }
+        return Data()[index];
+    }
+
+    // Возвращает false, только если политика отклонила переполнение
+    bool PushBack(const Type& item) {
+        return EmplaceAt(size_, item) != nullptr;
+    }
+
+    bool PushBack(Type&& item) {
+        return EmplaceAt(size_, std::move(item)) != nullptr;
+    }
+
+    // Создаёт элемент в конце вектора из аргументов args.
+    // Аргументы могут ссылаться на элементы самого вектора
+    template <typename... Args>
+    EmplaceResult EmplaceBack(Args&&... args) {
+        const Iterator item = EmplaceAt(size_, std::forward<Args>(args)...);
+        if constexpr (OverflowPolicy::REJECT) {
+            return item;
+        } else {
+            return *item;
+        }
+    }
+
+    // Создаёт элемент из аргументов args в позиции pos.
+    // Возвращает итератор на созданный элемент или nullptr, если вставка отклонена.
+    // Итераторы вектора указывают внутрь объекта и нулевыми не бывают, поэтому отказ
+    // не спутать с успешной вставкой, вернувшей end()
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        assert(pos >= begin() && pos <= end());
+        return EmplaceAt(pos - cbegin(), std::forward<Args>(args)...);
+    }
+
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Вставляет count копий value в позицию pos, сдвигая хвост один раз.
+    // Возвращает итератор на первый вставленный элемент (при count == 0 — pos)
+    // или nullptr, если вставка отклонена
+    Iterator Insert(ConstIterator pos, size_t count, const Type& value) {
+        assert(pos >= begin() && pos <= end());
+        const size_t dist = pos - cbegin();
+        if (!FitsMore(count)) {
+            return nullptr;
+        }
+        if (std::less_equal<const Type*>()(cbegin(), &value) && std::less<const Type*>()(&value, cend())) {
+            // value — элемент самого вектора, который может быть сдвинут
+            const Type copy(value);
+            return InsertN(dist, count, [&](Type* dest) {
+                UninitializedFillN(dest, count, copy);
+            });
+        }
+        return InsertN(dist, count, [&](Type* dest) {
+            UninitializedFillN(dest, count, value);
+        });
+    }
+
+    // Вставляет элементы диапазона [first, last) в позицию pos. Диапазон не должен указывать
+    // на элементы самого вектора. Если элементы не помещаются, вектор не меняется.
+    // Возвращает итератор на первый вставленный элемент (для пустого диапазона — pos)
+    // или nullptr, если вставка отклонена
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    Iterator Insert(ConstIterator pos, InputIt first, InputIt last) {
+        assert(pos >= begin() && pos <= end());
+        const size_t dist = pos - cbegin();
+        if constexpr (IsForwardIteratorV<InputIt>) {
+            const size_t count = std::distance(first, last);
+            if (!FitsMore(count)) {
+                return nullptr;
+            }
+            return InsertN(dist, count, [&](Type* dest) {
+                UninitializedCopy(first, last, dest);
+            });
+        } else {
+            // Длина однопроходного диапазона заранее неизвестна: элементы дописываются в конец
+            // и затем поворачиваются на место, а при переполнении дописанное удаляется
+            const size_t old_size = size_;
+            try {
+                for (; first != last; ++first) {
+                    if (EmplaceAt(size_, *first) == nullptr) {
+                        Truncate(old_size);
+                        return nullptr;
+                    }
+                }
+            } catch (...) {
+                Truncate(old_size);
+                throw;
+            }
+            std::rotate(begin() + dist, begin() + old_size, end());
+            return begin() + dist;
+        }
+    }
+
+    // Добавляет элементы диапазона [first, last) в конец вектора.
+    // Возвращает false, только если политика отклонила переполнение
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    bool Append(InputIt first, InputIt last) {
+        return Insert(cend(), first, last) != nullptr;
+    }
+
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        assert(size_ > 0);
+        --size_;
+        std::destroy_at(end());
+    }
+
+    // Удаляет элемент вектора в указанной позиции
+    Iterator Erase(ConstIterator pos) {
+        assert(pos >= begin() && pos < end());
+        const Iterator new_pos = begin() + (pos - cbegin());
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            std::destroy_at(new_pos);
+            RelocateShift(new_pos + 1, end(), -1);
+            --size_;
+        } else {
+            std::move(new_pos + 1, end(), new_pos);
+            PopBack();
+        }
+        return new_pos;
+    }
+
+    // Удаляет элементы диапазона [first, last), сдвигая хвост один раз.
+    // Возвращает итератор на элемент, следовавший за удалёнными
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        assert(first >= begin() && first <= last && last <= end());
+        const Iterator new_first = begin() + (first - cbegin());
+        const Iterator new_last = begin() + (last - cbegin());
+        const size_t count = new_last - new_first;
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            std::destroy(new_first, new_last);
+            RelocateShift(new_last, end(), -static_cast<std::ptrdiff_t>(count));
+        } else {
+            std::move(new_last, end(), new_first);
+            std::destroy(end() - count, end());
+        }
+        size_ -= count;
+        return new_first;
+    }
+
+    // Вместимость постоянна, поэтому Reserve лишь проверяет, что capacity элементов помещаются
+    bool Reserve(size_t capacity) {
+        return Fits(capacity);
+    }
+
+    // Изменяет размер массива.
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type.
+    // Возвращает false, только если политика отклонила переполнение
+    bool Resize(size_t new_size) {
+        if (new_size <= size_) {
+            Truncate(new_size);
+            return true;
+        }
+        if (!Fits(new_size)) {
+            return false;
+        }
+        UninitializedValueConstructN(end(), new_size - size_);
+        size_ = new_size;
+        return true;
+    }
+
+    // Разрушает все элементы
+    void Clear() noexcept {
+        Truncate(0);
+    }
+
+    // Обменивает элементы с other: общая часть обменивается поэлементно,
+    // остаток более длинного вектора переносится в более короткий
+    void swap(StaticVector& other) noexcept(std::is_nothrow_swappable_v<Type>
+                                            && std::is_nothrow_move_constructible_v<Type>) {
+        StaticVector& shorter = size_ < other.size_ ? *this : other;
+        StaticVector& longer = size_ < other.size_ ? other : *this;
+        std::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+        UninitializedRelocate(longer.begin() + shorter.size_, longer.end(), shorter.end());
+        std::swap(size_, other.size_);
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость массива
+    static constexpr size_t GetCapacity() noexcept {
+        return N;
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Сообщает, заполнена ли вся вместимость
+    bool IsFull() const noexcept {
+        return size_ == N;
+    }
+
+    Iterator begin() noexcept {
+        return Data();
+    }
+
+    Iterator end() noexcept {
+        return Data() + size_;
+    }
+
+    ConstIterator begin() const noexcept {
+        return Data();
+    }
+
+    ConstIterator end() const noexcept {
+        return Data() + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    Type* Data() noexcept {
+        return std::launder(reinterpret_cast<Type*>(storage_));
+    }
+
+    const Type* Data() const noexcept {
+        return std::launder(reinterpret_cast<const Type*>(storage_));
+    }
+
+    // Помещаются ли required элементов. Если нет, вызывает политику переполнения,
+    // которая либо не возвращает управление, либо отклоняет операцию
+    static bool Fits(size_t required) {
+        if (required <= N) {
+            return true;
+        }
+        OverflowPolicy::Overflow();
+        return false;
+    }
+
+    // Помещаются ли ещё count элементов. Сравнение с остатком вместимости
+    // не переполняется даже для count, близкого к SIZE_MAX
+    bool FitsMore(size_t count) const {
+        if (count <= N - size_) {
+            return true;
+        }
+        OverflowPolicy::Overflow();
+        return false;
+    }
+
+    // Разрушает элементы начиная с new_size
+    void Truncate(size_t new_size) noexcept {
+        std::destroy(begin() + new_size, end());
+        size_ = new_size;
+    }
+
+    // Присваивает count элементов source: общая часть — присваиванием, остаток —
+    // конструированием. take(item) возвращает ссылку, из которой копировать или перемещать
+    template <typename Source, typename Take>
+    void AssignFrom(Source* source, size_t count, Take take) {
+        const size_t common = std::min(size_, count);
+        for (size_t i = 0; i < common; ++i) {
+            Data()[i] = take(source[i]);
+        }
+        if (count <= size_) {
+            Truncate(count);
+            return;
+        }
+        for (; size_ < count; ++size_) {
+            std::construct_at(end(), take(source[size_]));
+        }
+    }
+
+    // Создаёт элемент из args в позиции dist. При сдвиге элемент сначала создаётся
+    // во временном объекте, поэтому args могут ссылаться на элементы самого вектора.
+    // Возвращает nullptr, если политика отклонила вставку
+    template <typename... Args>
+    Iterator EmplaceAt(size_t dist, Args&&... args) {
+        if (!FitsMore(1)) {
+            return nullptr;
+        }
+        const Iterator new_pos = begin() + dist;
+        if (new_pos == end()) {
+            std::construct_at(end(), std::forward<Args>(args)...);
+        } else if constexpr (IsTriviallyRelocatableV<Type>) {
+            Type tmp(std::forward<Args>(args)...);
+            RelocateShift(new_pos, end(), 1);
+            try {
+                std::construct_at(new_pos, std::move(tmp));
+            } catch (...) {
+                RelocateShift(new_pos + 1, end() + 1, -1);
+                throw;
+            }
+        } else {
+            Type tmp(std::forward<Args>(args)...);
+            std::construct_at(end(), std::move(*(end() - 1)));
+            ++size_;
+            std::move_backward(new_pos, end() - 2, end() - 1);
+            *new_pos = std::move(tmp);
+            return new_pos;
+        }
+        ++size_;
+        return new_pos;
+    }
+
+    // Вставляет count элементов в позицию dist; место уже проверено. construct(dest) должен
+    // создать их в неинициализированной памяти dest и при исключении сам разрушить созданное
+    template <typename Construct>
+    Iterator InsertN(size_t dist, size_t count, Construct construct) {
+        const Iterator pos = begin() + dist;
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            RelocateShift(pos, end(), static_cast<std::ptrdiff_t>(count));
+            try {
+                construct(pos);
+            } catch (...) {
+                RelocateShift(pos + count, end() + count, -static_cast<std::ptrdiff_t>(count));
+                throw;
+            }
+            size_ += count;
+        } else {
+            // Сдвиг на месте оставил бы дыру при исключении, поэтому элементы
+            // создаются в конце и затем поворачиваются на место
+            construct(end());
+            size_ += count;
+            std::rotate(pos, end() - count, end());
+        }
+        return pos;
+    }
+
+    alignas(Type) unsigned char storage_[N * sizeof(Type)];
+    size_t size_ = 0;
+};
+
+template <typename Type, size_t N, typename OverflowPolicy>
+inline bool operator==(const StaticVector<Type, N, OverflowPolicy>& lhs, const StaticVector<Type, N, OverflowPolicy>& rhs) {
+    return (lhs.GetSize() == rhs.GetSize())
+           && RangesEqual(lhs.begin(), rhs.begin(), lhs.GetSize());  // может бросить исключение
+}
+
+template <typename Type, size_t N, typename OverflowPolicy>
+inline bool operator!=(const StaticVector<Type, N, OverflowPolicy>& lhs, const StaticVector<Type, N, OverflowPolicy>& rhs) {
+    return !(lhs == rhs);  // может бросить исключение
+}
+
+template <typename Type, size_t N, typename OverflowPolicy>
+inline bool operator<(const StaticVector<Type, N, OverflowPolicy>& lhs, const StaticVector<Type, N, OverflowPolicy>& rhs) {
+    return RangesLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());  // может бросить исключение
+}
+
+template <typename Type, size_t N, typename OverflowPolicy>
+inline bool operator<=(const StaticVector<Type, N, OverflowPolicy>& lhs, const StaticVector<Type, N, OverflowPolicy>& rhs) {
+    return !(rhs < lhs);  // может бросить исключение
+}
+
+template <typename Type, size_t N, typename OverflowPolicy>
+inline bool operator>(const StaticVector<Type, N, OverflowPolicy>& lhs, const StaticVector<Type, N, OverflowPolicy>& rhs) {
+    return rhs < lhs;  // может бросить исключение
+}
+
+template <typename Type, size_t N, typename OverflowPolicy>
+inline bool operator>=(const StaticVector<Type, N, OverflowPolicy>& lhs, const StaticVector<Type, N, OverflowPolicy>& rhs) {
+    return rhs <= lhs;  // может бросить исключение
+}
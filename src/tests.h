@@ -1,6 +1,35 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
 #include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -427,3 +456,2431 @@ void Test4() {
     TestNoncopiableInsert();
     TestNoncopiableErase();
 }
+
+// Тип без конструктора по умолчанию, подсчитывающий живые экземпляры
+class Counted {
+public:
+    explicit Counted(int value)
+        : value_(value) {
+        ++alive;
+    }
+    Counted(const Counted& other)
+        : value_(other.value_) {
+        ++alive;
+    }
+    Counted(Counted&& other) noexcept
+        : value_(exchange(other.value_, 0)) {
+        ++alive;
+    }
+    Counted& operator=(const Counted& other) = default;
+    Counted& operator=(Counted&& other) noexcept {
+        value_ = exchange(other.value_, 0);
+        return *this;
+    }
+    ~Counted() {
+        --alive;
+    }
+    int GetValue() const {
+        return value_;
+    }
+
+    inline static int alive = 0;
+
+private:
+    int value_;
+};
+
+void TestUninitializedCapacity() {
+    cout << "Test uninitialized capacity" << endl;
+    {
+        SimpleVector<Counted> v(Reserve(100));
+        assert(Counted::alive == 0);
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(Counted(i));
+        }
+        assert(Counted::alive == 10);
+        v.Reserve(1000);
+        assert(Counted::alive == 10);
+
+        v.Insert(v.begin() + 3, Counted(42));
+        assert(Counted::alive == 11);
+        assert(v[3].GetValue() == 42);
+        assert(v[4].GetValue() == 3);
+
+        v.Erase(v.begin());
+        assert(Counted::alive == 10);
+        assert(v[0].GetValue() == 1);
+
+        v.PopBack();
+        assert(Counted::alive == 9);
+
+        v.Clear();
+        assert(Counted::alive == 0);
+        assert(v.GetCapacity() == 1000);
+
+        v.PushBack(Counted(7));
+    }
+    assert(Counted::alive == 0);
+    {
+        SimpleVector<Counted> v(5, Counted(3));
+        SimpleVector<Counted> copy(v);
+        assert(Counted::alive == 10);
+        SimpleVector<Counted> moved(move(copy));
+        assert(Counted::alive == 10);
+        assert(copy.IsEmpty());
+        assert(moved[4].GetValue() == 3);
+    }
+    assert(Counted::alive == 0);
+    cout << "Done!" << endl;
+}
+
+void Test5() {
+    TestUninitializedCapacity();
+}
+
+// Тип с нетривиальными конструкторами, помеченный пользователем как тривиально перемещаемый
+struct OwningHandle {
+    explicit OwningHandle(int value)
+        : ptr(make_unique<int>(value)) {
+    }
+    unique_ptr<int> ptr;
+};
+
+template <>
+struct IsTriviallyRelocatable<OwningHandle> : std::true_type {};
+
+void TestTriviallyRelocatable() {
+    cout << "Test trivially relocatable types" << endl;
+    static_assert(IsTriviallyRelocatableV<uint64_t>);
+    static_assert(!IsTriviallyRelocatableV<string>);
+    {
+        SimpleVector<uint64_t> v;
+        for (uint64_t i = 0; i < 1000; ++i) {
+            v.PushBack(i);
+        }
+        v.Insert(v.begin() + 500, 42);
+        v.Insert(v.end(), 43);
+        v.Insert(v.begin(), 44);
+        assert(v.GetSize() == 1003);
+        assert(v[0] == 44 && v[501] == 42 && v[1002] == 43);
+        assert(v[1] == 0 && v[500] == 499 && v[502] == 500);
+        v.Erase(v.begin() + 501);
+        v.Erase(v.begin());
+        for (uint64_t i = 0; i < 1000; ++i) {
+            assert(v[i] == i);
+        }
+        v.Reserve(5000);
+        v.Resize(10000);
+        assert(v[999] == 999 && v[1000] == 43 && v[9999] == 0);
+    }
+    {
+        SimpleVector<OwningHandle> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(OwningHandle(i));
+        }
+        v.Insert(v.begin() + 10, OwningHandle(-1));
+        assert(*v[10].ptr == -1 && *v[11].ptr == 10);
+        v.Erase(v.begin() + 10);
+        for (int i = 0; i < 100; ++i) {
+            assert(*v[i].ptr == i);
+        }
+        v.Reserve(1000);
+        assert(*v[99].ptr == 99);
+    }
+    cout << "Done!" << endl;
+}
+
+void Test6() {
+    TestTriviallyRelocatable();
+}
+
+void TestAllocators() {
+    cout << "Test allocators" << endl;
+    {
+        MonotonicArena arena(64);
+        ArenaAllocator<int> alloc(arena);
+        SimpleVector<int, ArenaAllocator<int>> v(alloc);
+        v.PushBack(1);
+        const int* const old_begin = v.begin();
+        for (int i = 2; i <= 8; ++i) {
+            v.PushBack(i);
+        }
+        // Последний блок арены растёт на месте
+        assert(v.begin() == old_begin);
+        assert(v.GetSize() == 8 && v[7] == 8);
+
+        SimpleVector<string, ArenaAllocator<string>> strings(3, "arena"s, ArenaAllocator<string>(arena));
+        strings.Insert(strings.begin() + 1, "middle"s);
+        strings.Erase(strings.begin());
+        assert(strings.GetSize() == 3 && strings[0] == "middle"s);
+
+        auto copy = v;
+        assert(copy == v);
+        assert(copy.GetAllocator() == alloc);
+        assert(arena.GetAllocatedBytes() > 0);
+    }
+    {
+        alignas(16) unsigned char buffer[256];
+        MonotonicArena arena(buffer, sizeof(buffer));
+        SimpleVector<uint64_t, ArenaAllocator<uint64_t>> v(Reserve(8), ArenaAllocator<uint64_t>(arena));
+        const auto* const begin = reinterpret_cast<const unsigned char*>(v.begin());
+        assert(begin >= buffer && begin < buffer + sizeof(buffer));
+        for (uint64_t i = 0; i < 1000; ++i) {
+            v.PushBack(i);
+        }
+        assert(v[999] == 999);
+        v.Clear();
+        arena.Release();
+        assert(arena.GetAllocatedBytes() == 0);
+    }
+    {
+        std::pmr::monotonic_buffer_resource resource;
+        using PmrVector = SimpleVector<int, std::pmr::polymorphic_allocator<int>>;
+        PmrVector v{std::pmr::polymorphic_allocator<int>(&resource)};
+        for (int i = 0; i < 100; ++i) {
+            v.Insert(v.begin(), i);
+        }
+        assert(v[0] == 99 && v[99] == 0);
+        PmrVector other(5, 7, std::pmr::polymorphic_allocator<int>(&resource));
+        other = v;
+        assert(other == v);
+        assert(other.GetAllocator().resource() == &resource);
+    }
+    {
+        // Блок, размер которого в байтах не представим в size_t, не выделяется урезанным
+        MallocAllocator<uint64_t> malloc_alloc;
+        try {
+            (void)malloc_alloc.allocate(malloc_alloc.max_size() + 1);
+            assert(false);
+        } catch (const bad_array_new_length&) {
+        }
+        try {
+            (void)malloc_alloc.reallocate(nullptr, 0, malloc_alloc.max_size() + 1);
+            assert(false);
+        } catch (const bad_array_new_length&) {
+        }
+
+        MonotonicArena arena;
+        ArenaAllocator<uint64_t> arena_alloc(arena);
+        try {
+            (void)arena_alloc.allocate(arena_alloc.max_size() + 1);
+            assert(false);
+        } catch (const bad_array_new_length&) {
+        }
+        try {
+            (void)arena.Allocate(numeric_limits<size_t>::max(), 16);
+            assert(false);
+        } catch (const bad_array_new_length&) {
+        }
+        assert(arena.GetAllocatedBytes() == 0);
+
+        SimpleVector<uint64_t> v{1, 2, 3};
+        try {
+            v.Reserve(numeric_limits<size_t>::max() / 4);
+            assert(false);
+        } catch (const bad_array_new_length&) {
+        }
+        assert((v == SimpleVector<uint64_t>{1, 2, 3}));
+    }
+    cout << "Done!" << endl;
+}
+
+void Test7() {
+    TestAllocators();
+}
+
+// Подсчитывает копирования и перемещения
+struct CopyMoveCounter {
+    CopyMoveCounter(int id, string name)
+        : id(id), name(move(name)) {
+    }
+    CopyMoveCounter(const CopyMoveCounter& other)
+        : id(other.id), name(other.name) {
+        ++copies;
+    }
+    CopyMoveCounter(CopyMoveCounter&& other) noexcept
+        : id(other.id), name(move(other.name)) {
+        ++moves;
+    }
+    CopyMoveCounter& operator=(const CopyMoveCounter& other) {
+        id = other.id;
+        name = other.name;
+        ++copies;
+        return *this;
+    }
+    CopyMoveCounter& operator=(CopyMoveCounter&& other) noexcept {
+        id = other.id;
+        name = move(other.name);
+        ++moves;
+        return *this;
+    }
+
+    int id;
+    string name;
+    inline static int copies = 0;
+    inline static int moves = 0;
+};
+
+void TestEmplace() {
+    cout << "Test emplace" << endl;
+    {
+        SimpleVector<CopyMoveCounter> v(Reserve(4));
+        CopyMoveCounter::copies = CopyMoveCounter::moves = 0;
+        v.EmplaceBack(1, "one"s);
+        auto& back = v.EmplaceBack(2, "two"s);
+        assert(&back == &v[1]);
+        assert(CopyMoveCounter::copies == 0 && CopyMoveCounter::moves == 0);
+
+        auto it = v.Emplace(v.begin(), 0, "zero"s);
+        assert(it == v.begin() && it->name == "zero"s);
+        assert(v[1].id == 1 && v[2].id == 2);
+        assert(CopyMoveCounter::copies == 0);
+    }
+    {
+        // Аргументы ссылаются на элементы вектора, в том числе при переполнении
+        SimpleVector<string> v{"a"s, "b"s, "c"s};
+        assert(v.GetSize() == v.GetCapacity());
+        v.PushBack(v[0]);
+        assert(v[3] == "a"s);
+        v.EmplaceBack(v[1]);
+        assert(v[4] == "b"s);
+        v.Insert(v.begin(), v[2]);
+        assert(v[0] == "c"s && v[3] == "c"s);
+        v.Emplace(v.begin() + 1, v[5]);
+        assert((v == SimpleVector<string>{"c"s, "b"s, "a"s, "b"s, "c"s, "a"s, "b"s}));
+        v.Emplace(v.end(), 3, 'x');
+        assert(v[7] == "xxx"s);
+    }
+    {
+        SimpleVector<uint64_t> v{1, 2};
+        v.PushBack(v[1]);
+        v.Emplace(v.begin(), v[2]);
+        v.Emplace(v.begin() + 2, v[0]);
+        assert((v == SimpleVector<uint64_t>{2, 1, 2, 2, 2}));
+    }
+    {
+        SmallSimpleVector<string, 2> v{"a"s, "b"s};
+        v.EmplaceBack(v[0]);
+        v.Emplace(v.begin(), 2, 'z');
+        assert(v[0] == "zz"s && v[3] == "a"s);
+    }
+    cout << "Done!" << endl;
+}
+
+void Test8() {
+    TestEmplace();
+}
+
+void TestRangeOperations() {
+    cout << "Test range operations" << endl;
+    {
+        const vector<int> source{1, 2, 3, 4, 5};
+        SimpleVector<int> v(source.begin(), source.end());
+        assert((v == SimpleVector<int>{1, 2, 3, 4, 5}));
+        assert(v.GetCapacity() == 5);
+
+        const vector<int> middle{10, 11, 12};
+        auto it = v.Insert(v.begin() + 2, middle.begin(), middle.end());
+        assert(it == v.begin() + 2);
+        assert((v == SimpleVector<int>{1, 2, 10, 11, 12, 3, 4, 5}));
+
+        v.Insert(v.begin(), 2, 0);
+        v.Insert(v.end(), 1, v[0]);
+        assert((v == SimpleVector<int>{0, 0, 1, 2, 10, 11, 12, 3, 4, 5, 0}));
+
+        it = v.Erase(v.begin() + 4, v.begin() + 7);
+        assert(*it == 3);
+        assert((v == SimpleVector<int>{0, 0, 1, 2, 3, 4, 5, 0}));
+
+        v.Append(middle.begin(), middle.end());
+        assert(v.GetSize() == 11 && v[10] == 12);
+        v.Erase(v.begin(), v.end());
+        assert(v.IsEmpty());
+    }
+    {
+        // Размер, не помещающийся в size_t вместе с имеющимися элементами, отвергается до выделения памяти
+        SimpleVector<int> v{1};
+        try {
+            v.Insert(v.cend(), numeric_limits<size_t>::max(), 7);
+            assert(false);
+        } catch (const length_error&) {
+        }
+        try {
+            v.Insert(v.cbegin(), v.GetMaxSize(), 7);
+            assert(false);
+        } catch (const length_error&) {
+        }
+        assert((v == SimpleVector<int>{1}) && v.GetCapacity() == 1);
+    }
+    {
+        // Вставка в середину большого вектора растит память один раз
+        SimpleVector<string> v(Reserve(4));
+        v.PushBack("a"s);
+        v.PushBack("z"s);
+        const vector<string> batch(100, "m"s);
+        v.Insert(v.begin() + 1, batch.begin(), batch.end());
+        assert(v.GetSize() == 102 && v[0] == "a"s && v[1] == "m"s && v[101] == "z"s);
+
+        v.Insert(v.begin() + 1, 3, v[101]);
+        assert(v[1] == "z"s && v[3] == "z"s && v[4] == "m"s);
+
+        v.Erase(v.begin() + 1, v.begin() + 104);
+        assert((v == SimpleVector<string>{"a"s, "z"s}));
+
+        const size_t capacity = v.GetCapacity();
+        v.Insert(v.begin() + 1, 2, "q"s);
+        assert(v.GetCapacity() == capacity);
+        assert((v == SimpleVector<string>{"a"s, "q"s, "q"s, "z"s}));
+    }
+    {
+        istringstream input("5 6 7");
+        SimpleVector<int> v{1, 9};
+        v.Insert(v.begin() + 1, istream_iterator<int>(input), istream_iterator<int>());
+        assert((v == SimpleVector<int>{1, 5, 6, 7, 9}));
+    }
+    {
+        SimpleVector<X> source;
+        for (size_t i = 0; i < 4; ++i) {
+            source.PushBack(X(i));
+        }
+        SimpleVector<X> v;
+        v.PushBack(X(100));
+        v.Insert(v.begin(), make_move_iterator(source.begin()), make_move_iterator(source.end()));
+        assert(v.GetSize() == 5 && v[0].GetX() == 0 && v[3].GetX() == 3 && v[4].GetX() == 100);
+        v.Erase(v.begin() + 1, v.begin() + 3);
+        assert(v.GetSize() == 3 && v[1].GetX() == 3);
+    }
+    cout << "Done!" << endl;
+}
+
+void Test9() {
+    TestRangeOperations();
+}
+
+void TestGrowthPolicies() {
+    cout << "Test growth policies" << endl;
+    {
+        SimpleVector<int> v;
+        v.PushBack(1);
+        v.PushBack(2);
+        v.PushBack(3);
+        assert(v.GetCapacity() == 4);
+        v.Resize(1000);
+        // Resize больше не удваивает запрошенный размер
+        assert(v.GetCapacity() == 1000);
+        v.Resize(1001);
+        assert(v.GetCapacity() == 2000);
+    }
+    {
+        SimpleVector<int, MallocAllocator<int>, OneAndHalfGrowth> v(Reserve(10));
+        v.Resize(11);
+        assert(v.GetCapacity() == 15);
+    }
+    {
+        SimpleVector<string, MallocAllocator<string>, ExactGrowth> v;
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(to_string(i));
+            assert(v.GetCapacity() == v.GetSize());
+        }
+        v.Insert(v.begin(), 3, "x"s);
+        assert(v.GetCapacity() == 8);
+    }
+    {
+        SimpleVector<char, MallocAllocator<char>, MallocSizeClassGrowth<>> v;
+        v.PushBack('a');
+        assert(v.GetCapacity() >= 16);
+        assert(v.GetCapacity() == MallocSizeClass(v.GetCapacity()));
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack('b');
+        }
+        assert(v.GetCapacity() == MallocSizeClass(v.GetCapacity()));
+        assert(v.GetSize() == 1001 && v[0] == 'a' && v[1000] == 'b');
+    }
+    {
+        SimpleVector<string> v(Reserve(100));
+        v.PushBack("a"s);
+        v.PushBack("b"s);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 2);
+        assert((v == SimpleVector<string>{"a"s, "b"s}));
+        v.Clear();
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 0 && v.begin() == nullptr);
+
+        SimpleVector<uint64_t> numbers(Reserve(1000));
+        numbers.Resize(10);
+        numbers.ShrinkToFit();
+        assert(numbers.GetCapacity() == 10 && numbers[9] == 0);
+    }
+    cout << "Done!" << endl;
+}
+
+void Test10() {
+    TestGrowthPolicies();
+}
+
+// Сверяет ==, <, > и FindFirstMismatch с поэлементными алгоритмами стандартной библиотеки
+template <typename Type>
+void CheckComparison(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+    assert((lhs == rhs) == (lhs.GetSize() == rhs.GetSize() && equal(lhs.begin(), lhs.end(), rhs.begin())));
+    assert((lhs < rhs) == lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+    assert((lhs > rhs) == lexicographical_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end()));
+    const size_t common = min(lhs.GetSize(), rhs.GetSize());
+    assert(FindFirstMismatch(lhs, rhs) == size_t(mismatch(lhs.begin(), lhs.begin() + common, rhs.begin()).first - lhs.begin()));
+}
+
+// Для каждой длины, пересекающей границы векторных регистров, и каждой позиции
+// меняет один элемент копии на значения из values и сравнивает
+template <typename Type>
+void CheckComparisonKernels(const vector<Type>& values) {
+    mt19937 generator(42);
+    for (size_t size : {0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 100}) {
+        SimpleVector<Type> lhs(size);
+        for (auto& item : lhs) {
+            item = values[generator() % values.size()];
+        }
+        SimpleVector<Type> rhs(lhs);
+        CheckComparison(lhs, rhs);
+        for (size_t i = 0; i < size; ++i) {
+            for (const Type& value : values) {
+                const Type old = rhs[i];
+                rhs[i] = value;
+                CheckComparison(lhs, rhs);
+                CheckComparison(rhs, lhs);
+                rhs[i] = old;
+            }
+        }
+        // Один вектор — начало другого
+        if (size > 0) {
+            SimpleVector<Type> prefix(lhs.begin(), lhs.end() - 1);
+            CheckComparison(prefix, lhs);
+            CheckComparison(lhs, prefix);
+        }
+    }
+}
+
+void TestSimdComparison() {
+    cout << "Test SIMD comparison" << endl;
+    CheckComparisonKernels<uint8_t>({0, 1, 0x7F, 0x80, 0xFF});
+    CheckComparisonKernels<int8_t>({-128, -1, 0, 1, 127});
+    CheckComparisonKernels<bool>({false, true});
+    CheckComparisonKernels<int16_t>({-32768, -256, -1, 0, 1, 255, 256});
+    CheckComparisonKernels<int32_t>({numeric_limits<int32_t>::min(), -1, 0, 1, 0x100, numeric_limits<int32_t>::max()});
+    CheckComparisonKernels<uint32_t>({0, 1, 0x100, 0x80000000u, 0xFFFFFFFFu});
+    CheckComparisonKernels<int64_t>({numeric_limits<int64_t>::min(), -1, 0, 1, int64_t(1) << 40});
+
+    // Для чисел с плавающей точкой -0.0 == 0.0, а NaN не равен сам себе и не упорядочен
+    const float nan_f = numeric_limits<float>::quiet_NaN();
+    CheckComparisonKernels<float>({-numeric_limits<float>::infinity(), -1.5f, -0.0f, 0.0f, 1e-40f, 2.0f, nan_f});
+    const double nan_d = numeric_limits<double>::quiet_NaN();
+    CheckComparisonKernels<double>({-1e300, -1.0, -0.0, 0.0, 5e-324, 3.0, nan_d});
+    {
+        SimpleVector<float> lhs{1.0f, -0.0f, 3.0f};
+        SimpleVector<float> rhs{1.0f, 0.0f, 3.0f};
+        assert(lhs == rhs);
+        assert(FindFirstMismatch(lhs, rhs) == 3);
+        rhs[0] = lhs[0] = nan_f;
+        assert(lhs != rhs);
+        assert(FindFirstMismatch(lhs, rhs) == 0);
+        assert(!(lhs < rhs) && !(rhs < lhs));
+    }
+    {
+        SimpleVector<int> lhs{1, 2, -3};
+        SimpleVector<int> rhs{1, 2, 3};
+        assert(FindFirstMismatch(lhs, rhs) == 2);
+        assert(lhs < rhs);
+        const int raw[] = {1, 2, 3};
+        assert(FindFirstMismatch(raw, rhs.begin(), 3) == 3);
+    }
+    cout << "Done!" << endl;
+}
+
+void TestThreadPool() {
+    cout << "Test work-stealing thread pool" << endl;
+    WorkStealingThreadPool pool(4);
+    assert(pool.GetWorkerCount() == 4);
+    {
+        // Каждый индекс обрабатывается ровно один раз, отрезки не длиннее grain
+        vector<atomic<int>> visits(10'007);
+        pool.ParallelFor(visits.size(), 100, [&](size_t begin, size_t end) {
+            assert(end - begin <= 100);
+            for (size_t i = begin; i < end; ++i) {
+                ++visits[i];
+            }
+        });
+        assert(all_of(visits.begin(), visits.end(), [](const atomic<int>& count) {
+            return count == 1;
+        }));
+    }
+    {
+        // Вложенные вызовы из задач не блокируют пул
+        atomic<size_t> total = 0;
+        pool.ParallelFor(16, 1, [&](size_t, size_t) {
+            pool.ParallelFor(1000, 10, [&](size_t begin, size_t end) {
+                total += end - begin;
+            });
+        });
+        assert(total == 16 * 1000);
+    }
+    {
+        // Исключение из задачи пробрасывается вызывающему
+        bool thrown = false;
+        try {
+            pool.ParallelFor(1000, 1, [](size_t begin, size_t) {
+                if (begin == 500) {
+                    throw runtime_error("chunk failed");
+                }
+            });
+        } catch (const runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    cout << "Done!" << endl;
+}
+
+void TestParallelOperations() {
+    cout << "Test parallel construction and algorithms" << endl;
+    const size_t size = 100'003;
+    {
+        SimpleVector<int> v;
+        ParallelResize(v, size, Parallel(1000));
+        assert(v.GetSize() == size && v.GetCapacity() == size);
+        assert(all_of(v.begin(), v.end(), [](int item) {
+            return item == 0;
+        }));
+
+        SimpleVector<int> filled;
+        ParallelResize(filled, size, 7, Parallel(1000));
+        assert(filled.GetSize() == size);
+        assert(all_of(filled.begin(), filled.end(), [](int item) {
+            return item == 7;
+        }));
+
+        ParallelResize(filled, size * 2, Parallel(1000));
+        assert(filled.GetSize() == size * 2);
+        assert(filled[size - 1] == 7 && filled[size] == 0 && filled[size * 2 - 1] == 0);
+        ParallelResize(filled, 10);
+        assert(filled.GetSize() == 10 && filled[9] == 7);
+    }
+    {
+        SimpleVector<int64_t> v(size);
+        iota(v.begin(), v.end(), 0);
+        ParallelForEach(v, [](int64_t& item) {
+            item *= 2;
+        }, Parallel(999));
+        assert(v[size - 1] == int64_t(size - 1) * 2);
+        assert(ParallelReduce(v, int64_t(5), plus<>(), Parallel(999)) == 5 + int64_t(size) * int64_t(size - 1));
+
+        SimpleVector<double> halves;
+        ParallelTransform(v, halves, [](int64_t item) {
+            return item / 2.0;
+        }, Parallel(999));
+        assert(halves.GetSize() == size && halves[12345] == 12345.0);
+
+        ParallelFill(v, int64_t(3));
+        assert(all_of(v.begin(), v.end(), [](int64_t item) {
+            return item == 3;
+        }));
+        // Несколько отрезков объединяются по порядку: операция не обязана быть коммутативной
+        SimpleVector<string> words;
+        ParallelResize(words, 10, "a"s, Parallel(3));
+        assert(ParallelReduce(words, ">"s, plus<>(), Parallel(3)) == ">aaaaaaaaaa");
+    }
+    {
+        // Тип, копирование которого может бросить исключение, копируется в одном потоке
+        Counted::alive = 0;
+        SimpleVector<Counted> v;
+        ParallelResize(v, 1000, Counted(1), Parallel(10));
+        assert(v.GetSize() == 1000 && Counted::alive == 1000);
+    }
+    assert(Counted::alive == 0);
+    cout << "Done!" << endl;
+}
+
+// Отображения и большие страницы HugePageAllocator есть только в Linux
+#if defined(__linux__)
+void TestHugePageAllocator() {
+    cout << "Test huge page allocator" << endl;
+    // Порог в 4 КБ, чтобы отображённая память использовалась уже на небольших векторах
+    using Alloc = HugePageAllocator<int, 4096>;
+    static_assert(is_same_v<allocator_traits<Alloc>::rebind_alloc<char>, HugePageAllocator<char, 4096>>);
+    assert(!Alloc::IsMapped(1023) && Alloc::IsMapped(1024));
+    assert(Alloc::MappedBytes(1024) == Alloc::HUGE_PAGE_SIZE);
+    {
+        // Рост через порог и дальше через mremap, затем сжатие обратно в кучу
+        SimpleVector<int, Alloc> v;
+        for (int i = 0; i < 1'000'000; ++i) {
+            v.PushBack(i);
+        }
+        assert(Alloc::IsMapped(v.GetCapacity()));
+        assert(reinterpret_cast<uintptr_t>(v.begin()) % Alloc::HUGE_PAGE_SIZE == 0);
+        for (int i = 0; i < 1'000'000; ++i) {
+            assert(v[i] == i);
+        }
+        v.Resize(100);
+        v.ShrinkToFit();
+        assert(!Alloc::IsMapped(v.GetCapacity()));
+        assert(v.GetSize() == 100 && v[99] == 99);
+
+        SimpleVector<int, Alloc> copy(5000, 7);
+        copy.Reserve(3000000);
+        assert(copy.GetSize() == 5000 && copy[4999] == 7);
+        assert(reinterpret_cast<uintptr_t>(copy.begin()) % Alloc::HUGE_PAGE_SIZE == 0);
+        swap(copy, v);
+        assert(v.GetSize() == 5000 && copy.GetSize() == 100);
+    }
+    {
+        // Не тривиально перемещаемые элементы переносятся поэлементно
+        SimpleVector<string, HugePageAllocator<string, 4096>> strings;
+        for (int i = 0; i < 10'000; ++i) {
+            strings.PushBack(to_string(i));
+        }
+        assert(strings[9999] == "9999");
+    }
+    {
+        // Блоки выровнены по большой странице, в том числе после переноса mremap,
+        // когда расти на месте мешает соседнее отображение
+        Alloc alloc;
+        int* blocks[4];
+        for (int*& block : blocks) {
+            block = alloc.allocate(1024);
+            block[0] = 42;
+            assert(reinterpret_cast<uintptr_t>(block) % Alloc::HUGE_PAGE_SIZE == 0);
+        }
+        blocks[0] = alloc.reallocate(blocks[0], 1024, 4 << 20);
+        assert(reinterpret_cast<uintptr_t>(blocks[0]) % Alloc::HUGE_PAGE_SIZE == 0 && blocks[0][0] == 42);
+        alloc.deallocate(blocks[0], 4 << 20);
+        for (int i = 1; i < 4; ++i) {
+            alloc.deallocate(blocks[i], 1024);
+        }
+    }
+    {
+        Alloc alloc;
+        try {
+            (void)alloc.allocate(alloc.max_size() + 1);
+            assert(false);
+        } catch (const bad_array_new_length&) {
+        }
+        try {
+            (void)alloc.reallocate(nullptr, 0, alloc.max_size() + 1);
+            assert(false);
+        } catch (const bad_array_new_length&) {
+        }
+    }
+    {
+        // Индексы от 2^31 не обрезаются до int: отображение ленивое, касаемся двух страниц
+        const size_t large_index = size_t{1} << 31;
+        ArrayPtr<char, HugePageAllocator<char>> bytes(large_index + 1);
+        bytes[0] = 'a';
+        bytes[large_index] = 'b';
+        assert(&bytes[large_index] == bytes.Get() + large_index);
+        assert(bytes[0] == 'a' && bytes[large_index] == 'b');
+    }
+    cout << "Done!" << endl;
+}
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+void TestMappedSimpleVector() {
+    cout << "Test memory-mapped vector" << endl;
+    struct Record {
+        uint32_t id;
+        double weight;
+    };
+    const string path = (filesystem::temp_directory_path() / ("mapped_vector_test_" + to_string(getpid()))).string();
+    {
+        MappedSimpleVector<Record> v(path, MappedOpenMode::CREATE);
+        assert(v.IsEmpty() && !v.IsReadOnly());
+        for (uint32_t i = 0; i < 10'000; ++i) {
+            v.PushBack({i, i * 0.5});
+        }
+        v.PushBack(v[0]);
+        assert(v.GetSize() == 10'001 && v[10'000].id == 0);
+        v.PopBack();
+        v.Resize(10'100);
+        assert(v[10'099].id == 0 && v[10'099].weight == 0.0);
+        v.Resize(10'000);
+        v.Flush();
+        v.Sync();
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 10'000);
+        assert(filesystem::file_size(path) == MappedSimpleVector<Record>::DATA_OFFSET + 10'000 * sizeof(Record));
+    }
+    {
+        // Существующий файл открывается без чтения элементов
+        const MappedSimpleVector<Record> v(path, MappedOpenMode::READ_ONLY);
+        assert(v.IsReadOnly() && v.GetSize() == 10'000);
+        assert(v[1234].id == 1234 && v.At(9999).weight == 9999 * 0.5);
+        assert(all_of(v.begin(), v.end(), [](const Record& record) {
+            return record.weight == record.id * 0.5;
+        }));
+        try {
+            v.At(10'000);
+            assert(false);
+        } catch (const out_of_range&) {
+        }
+    }
+    {
+        MappedSimpleVector<Record> v(path, MappedOpenMode::READ_ONLY);
+        try {
+            v.PushBack({1, 1.0});
+            assert(false);
+        } catch (const logic_error&) {
+        }
+    }
+    {
+        MappedSimpleVector<Record> v(path);
+        v.Reserve(20'000);
+        v.PushBack({42, 1.0});
+        assert(v.GetSize() == 10'001 && v[10'000].id == 42);
+    }
+    {
+        // Другой размер элемента
+        try {
+            MappedSimpleVector<uint32_t> v(path, MappedOpenMode::READ_ONLY);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+    }
+    {
+        // Файл без заголовка
+        MappedSimpleVector<char>(path, MappedOpenMode::CREATE);
+        filesystem::resize_file(path, 64);
+        {
+            ofstream out(path, ios::binary | ios::in);
+            out << "garbage";
+        }
+        try {
+            MappedSimpleVector<char> v(path);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+    }
+    filesystem::remove(path);
+    cout << "Done!" << endl;
+}
+#endif
+
+// Поток без позиционирования, как у канала или сокета
+class UnseekableBuffer : public stringbuf {
+public:
+    using stringbuf::stringbuf;
+
+protected:
+    pos_type seekoff(off_type, ios_base::seekdir, ios_base::openmode) override {
+        return pos_type(off_type(-1));
+    }
+
+    pos_type seekpos(pos_type, ios_base::openmode) override {
+        return pos_type(off_type(-1));
+    }
+};
+
+void TestSerialization() {
+    cout << "Test serialization" << endl;
+    {
+        SimpleVector<int> v{1, -2, 3};
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(i * i);
+        }
+        stringstream stream;
+        Serialize(stream, v);
+        assert(stream.str().size() == sizeof(SerializedVectorHeader) + v.GetSize() * sizeof(int));
+        SimpleVector<int> restored{42};
+        Deserialize(stream, restored);
+        assert(restored == v);
+    }
+    {
+        SimpleVector<string> v{"", "short", string(100, 'x'), "with\0zero"s};
+        stringstream stream;
+        Serialize(stream, v);
+        SimpleVector<string> restored;
+        Deserialize(stream, restored);
+        assert(restored == v);
+
+        // Обрезанные данные и другой тип элементов
+        const string data = stream.str();
+        stringstream truncated(data.substr(0, data.size() - 1));
+        try {
+            Deserialize(truncated, restored);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        assert(restored.IsEmpty());
+        stringstream other_type(data);
+        SimpleVector<int> ints{1, 2};
+        try {
+            Deserialize(other_type, ints);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        assert(ints.IsEmpty());
+    }
+    {
+        // Размер из заголовка не принимается на веру
+        SimpleVector<int> v{1, 2, 3};
+        stringstream stream;
+        Serialize(stream, v);
+        string data = stream.str();
+        SerializedVectorHeader header;
+        memcpy(&header, data.data(), sizeof(header));
+        for (const uint64_t size : {uint64_t{4}, uint64_t{1} << 40, numeric_limits<uint64_t>::max() / 2}) {
+            header.size = size;
+            memcpy(data.data(), &header, sizeof(header));
+            stringstream crafted(data);
+            SimpleVector<int> restored{42};
+            try {
+                Deserialize(crafted, restored);
+                assert(false);
+            } catch (const runtime_error&) {
+            }
+            assert(restored.IsEmpty());
+
+            // Длину потока узнать нельзя: память растёт только по мере чтения данных
+            UnseekableBuffer buffer(data);
+            istream unseekable(&buffer);
+            try {
+                Deserialize(unseekable, restored);
+                assert(false);
+            } catch (const runtime_error&) {
+            }
+            assert(restored.IsEmpty() && restored.GetCapacity() < 1'000'000);
+        }
+        UnseekableBuffer buffer(stream.str());
+        istream unseekable(&buffer);
+        SimpleVector<int> restored;
+        Deserialize(unseekable, restored);
+        assert(restored == v);
+    }
+    {
+        // ReadFrom дописывает элементы прямо в хвост и останавливается на конце потока
+        const uint32_t values[] = {1, 2, 3, 4, 5};
+        stringstream stream(string(reinterpret_cast<const char*>(values), sizeof(values) - 1));
+        SimpleVector<uint32_t> v{0};
+        assert(ReadFrom(stream, v, 3) == 3);
+        assert((v == SimpleVector<uint32_t>{0, 1, 2, 3}));
+        assert(ReadFrom(stream, v, 10) == 1);
+        assert((v == SimpleVector<uint32_t>{0, 1, 2, 3, 4}));
+
+#if defined(__unix__) || defined(__APPLE__)
+
+        int fds[2];
+        assert(pipe(fds) == 0);
+        assert(write(fds[1], values, sizeof(values)) == sizeof(values));
+        close(fds[1]);
+        SimpleVector<uint32_t> from_fd;
+        assert(ReadFrom(fds[0], from_fd, 100) == 5);
+        assert(from_fd.GetCapacity() >= 100);
+        assert((from_fd == SimpleVector<uint32_t>{1, 2, 3, 4, 5}));
+        assert(ReadFrom(fds[0], from_fd, 100) == 0);
+        close(fds[0]);
+        try {
+            ReadFrom(-1, from_fd, 1);
+            assert(false);
+        } catch (const system_error&) {
+        }
+        assert(from_fd.GetSize() == 5);
+#endif
+
+        // Огромный count отвергается до выделения памяти, и fill не вызывается
+        bool filled = false;
+        try {
+            v.AppendUninitialized(numeric_limits<size_t>::max(), [&filled](uint32_t*, size_t) {
+                filled = true;
+                return size_t{0};
+            });
+            assert(false);
+        } catch (const length_error&) {
+        }
+        assert(!filled && v.GetSize() == 5);
+    }
+    cout << "Done!" << endl;
+}
+
+// Ресурс памяти, который отказывает в выделении, пока поднят флаг fail
+class FailingResource : public pmr::memory_resource {
+public:
+    bool fail = false;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (fail) {
+            throw bad_alloc();
+        }
+        return pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+void TestConcurrentSimpleVector() {
+    cout << "Test concurrent vector" << endl;
+    {
+        ConcurrentSimpleVector<int> v;
+        assert(v.IsEmpty() && v.GetCapacity() == 0);
+        int& first = v.PushBack(1);
+        for (int i = 2; i <= 1000; ++i) {
+            v.EmplaceBack(i);
+        }
+        // Адреса элементов не меняются при росте
+        assert(&first == &v[0]);
+        assert(v.GetSize() == 1000 && v[999] == 1000 && v.At(499) == 500);
+        assert(accumulate(v.begin(), v.end(), 0) == 500500);
+        try {
+            v.At(1000);
+            assert(false);
+        } catch (const out_of_range&) {
+        }
+        v.Clear();
+        assert(v.IsEmpty() && v.GetCapacity() >= 1000);
+        v.Reserve(100'000);
+        assert(v.GetCapacity() >= 100'000);
+    }
+    {
+        // Если корзину создать не удалось, ячейка не занимается и публикация не застревает
+        FailingResource resource;
+        ConcurrentSimpleVector<int, pmr::polymorphic_allocator<int>> v{pmr::polymorphic_allocator<int>(&resource)};
+        while (v.GetSize() < v.GetCapacity() || v.IsEmpty()) {
+            v.PushBack(static_cast<int>(v.GetSize()));
+        }
+        const size_t size = v.GetSize();
+        resource.fail = true;
+        try {
+            v.PushBack(-1);
+            assert(false);
+        } catch (const bad_alloc&) {
+        }
+        resource.fail = false;
+        v.PushBack(static_cast<int>(size));
+        assert(v.GetSize() == size + 1 && v[size] == static_cast<int>(size));
+    }
+    {
+        constexpr size_t THREADS = 8;
+        constexpr size_t PER_THREAD = 20'000;
+        ConcurrentSimpleVector<string> v;
+        const string* first = &v.PushBack("first");
+        atomic<bool> done = false;
+        // Читатель видит только опубликованные элементы, пока писатели добавляют новые
+        thread reader([&] {
+            while (!done) {
+                const size_t size = v.GetSize();
+                assert(&v[0] == first && v[0] == "first");
+                if (size > 1) {
+                    assert(!v[size - 1].empty());
+                }
+            }
+        });
+        vector<thread> writers;
+        for (size_t t = 0; t < THREADS; ++t) {
+            writers.emplace_back([&v, t] {
+                for (size_t i = 0; i < PER_THREAD; ++i) {
+                    v.PushBack(to_string(t * PER_THREAD + i));
+                }
+            });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        done = true;
+        reader.join();
+        assert(v.GetSize() == THREADS * PER_THREAD + 1);
+        vector<bool> seen(THREADS * PER_THREAD);
+        for (auto it = v.begin() + 1; it != v.end(); ++it) {
+            const size_t value = stoul(*it);
+            assert(!seen[value]);
+            seen[value] = true;
+        }
+    }
+    cout << "Done!" << endl;
+}
+
+void TestAlignedVector() {
+    cout << "Test aligned vector" << endl;
+    using Alloc = AlignedAllocator<float, 64>;
+    static_assert(Alloc::PaddedBytes(1) == 64 && Alloc::PaddedSize(17) == 32);
+    static_assert(is_same_v<allocator_traits<Alloc>::rebind_alloc<char>, AlignedAllocator<char, 64>>);
+    const auto is_aligned = [](const void* ptr) {
+        return reinterpret_cast<uintptr_t>(ptr) % 64 == 0;
+    };
+    {
+        // Начало буфера выровнено после любого перевыделения
+        SimpleAlignedVector<float> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(float(i));
+            assert(is_aligned(v.begin()));
+            // Вместимость кратна 16 float — одному регистру AVX-512
+            assert(v.GetCapacity() % 16 == 0);
+        }
+        v.Insert(v.begin() + 3, 100, -1.0f);
+        assert(is_aligned(v.begin()) && v.GetCapacity() % 16 == 0);
+        assert(v[3] == -1.0f && v[103] == 3.0f && v.GetSize() == 1100);
+        v.Reserve(5000);
+        assert(is_aligned(v.begin()));
+        v.Resize(20000);
+        assert(is_aligned(v.begin()) && v[19999] == 0.0f);
+        v.Resize(7);
+        v.ShrinkToFit();
+        assert(is_aligned(v.begin()) && v.GetCapacity() == 7);
+        // Хвост до конца регистра доступен для чтения, даже когда вместимость не кратна
+        const float* tail = v.begin() + Alloc::PaddedSize(v.GetSize()) - 1;
+        [[maybe_unused]] volatile float last = *tail;
+
+        const SimpleAlignedVector<float> copy(v);
+        assert(is_aligned(copy.begin()) && copy == v);
+    }
+    {
+        // Без добора вместимости и с выравниванием 32 байта
+        SimpleAlignedVector<double, 32, DoublingGrowth> v(3, 1.5);
+        v.PushBack(2.5);
+        assert(reinterpret_cast<uintptr_t>(v.begin()) % 32 == 0);
+        assert(v.GetCapacity() == 6 && v[3] == 2.5);
+
+        // Элементы, не перемещаемые побайтово, тоже попадают в выровненный буфер
+        SimpleAlignedVector<string> strings;
+        for (int i = 0; i < 100; ++i) {
+            strings.PushBack(to_string(i));
+            assert(is_aligned(strings.begin()));
+        }
+        assert(strings[99] == "99");
+    }
+    cout << "Done!" << endl;
+}
+
+void TestCowSimpleVector() {
+    cout << "Test copy-on-write vector" << endl;
+    {
+        CowSimpleVector<int> v{1, 2, 3};
+        assert(v.GetUseCount() == 1 && !v.IsShared());
+        // Копия разделяет буфер
+        CowSimpleVector<int> copy(v);
+        assert(copy.IsShared() && v.GetUseCount() == 2);
+        assert(&copy.GetItems() == &v.GetItems());
+        const auto& const_copy = copy;
+        assert(const_copy[1] == 2 && const_copy.At(2) == 3 && copy.IsShared());
+
+        // Первая запись клонирует буфер
+        copy[0] = 10;
+        assert(!copy.IsShared() && !v.IsShared());
+        assert(as_const(v)[0] == 1 && as_const(copy)[0] == 10);
+
+        CowSimpleVector<int> snapshot = v;
+        v.PushBack(4);
+        assert(v.GetSize() == 4 && snapshot.GetSize() == 3 && !snapshot.IsShared());
+        snapshot = v;
+        v.Insert(0, 0);
+        assert((v == CowSimpleVector<int>{0, 1, 2, 3, 4}));
+        assert((snapshot == CowSimpleVector<int>{1, 2, 3, 4}));
+        snapshot = v;
+        v.Erase(1, 3);
+        v.Erase(0);
+        assert((v == CowSimpleVector<int>{3, 4}) && snapshot.GetSize() == 5);
+        // Erase вернул итератор в буфер v, поэтому копия сразу получает свой буфер
+        snapshot = v;
+        assert(!v.IsShared() && !snapshot.IsShared());
+        v.Resize(5);
+        assert(v.GetSize() == 5 && snapshot.GetSize() == 2 && v > snapshot);
+        snapshot = v;
+        v.PopBack();
+        assert(v.GetSize() == 4 && snapshot.GetSize() == 5);
+
+        // Явный Detach. Новое значение — новый буфер, его снова можно разделять
+        v = CowSimpleVector<int>{3, 4, 0, 0};
+        snapshot = v;
+        assert(v.IsShared());
+        v.Detach();
+        assert(!v.IsShared() && !snapshot.IsShared() && v == snapshot);
+        v.Detach();
+        assert(v.GetUseCount() == 1);
+
+        // Clear разделённого вектора не копирует элементы
+        snapshot = v;
+        v.Clear();
+        assert(v.IsEmpty() && v.GetUseCount() == 0 && snapshot.GetSize() == 4);
+
+        CowSimpleVector<int> moved(std::move(snapshot));
+        assert(snapshot.IsEmpty() && moved.GetSize() == 4);
+        try {
+            moved.At(4);
+            assert(false);
+        } catch (const out_of_range&) {
+        }
+    }
+    {
+        // Ссылка и итератор, выданные до копирования, не меняют копию
+        CowSimpleVector<int> v{1, 2, 3};
+        int& first = v[0];
+        CowSimpleVector<int> copy = v;
+        assert(!v.IsShared() && !copy.IsShared());
+        first = 100;
+        assert(as_const(v)[0] == 100 && as_const(copy)[0] == 1);
+
+        auto it = v.begin() + 1;
+        CowSimpleVector<int> other_copy(v);
+        *it = 200;
+        assert((other_copy == CowSimpleVector<int>{100, 2, 3}));
+        assert((v == CowSimpleVector<int>{100, 200, 3}));
+
+        int& back = v.EmplaceBack(4);
+        copy = v;
+        back = 400;
+        assert(as_const(copy)[3] == 4 && as_const(v)[3] == 400);
+
+        // После Clear выданные ссылки недействительны, и буфер снова разделяется
+        v.Clear();
+        v.PushBack(5);
+        copy = v;
+        assert(v.IsShared() && copy.GetUseCount() == 2);
+    }
+    {
+        // Сотни снимков делят одну память
+        CowSimpleVector<string> table(SimpleVector<string>(1000, "route"));
+        vector<CowSimpleVector<string>> snapshots(500, table);
+        assert(table.GetUseCount() == 501);
+        for (auto& s : table) {
+            s = "changed";
+        }
+        assert(table.GetUseCount() == 1 && snapshots[0].GetUseCount() == 500);
+        assert(snapshots[499][999] == "route" && table[999] == "changed");
+    }
+    {
+        // Копии живут и меняются в разных потоках
+        const CowSimpleVector<int> shared(10'000, 1);
+        vector<thread> threads;
+        atomic<int> mismatches{0};
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&shared, &mismatches, t] {
+                for (int round = 0; round < 50; ++round) {
+                    CowSimpleVector<int> local(shared);
+                    local[round] = t;
+                    if (local.GetSize() != 10'000 || shared[round] != 1) {
+                        ++mismatches;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        assert(mismatches == 0 && shared.GetUseCount() == 1);
+    }
+    cout << "Done!" << endl;
+}
+
+void TestSimpleBitVector() {
+    cout << "Test bit vector" << endl;
+    {
+        SimpleBitVector<> bits;
+        assert(bits.IsEmpty() && bits.FindFirst() == 0);
+        for (int i = 0; i < 200; ++i) {
+            bits.PushBack(i % 3 == 0);
+        }
+        assert(bits.GetSize() == 200 && bits.GetWordCount() == 4);
+        assert(bits[0] && !bits[1] && bits[198] && !bits[199]);
+        assert(bits.Count() == 67 && bits.Rank(100) == 34 && bits.Rank(200) == 67);
+
+        // Прокси-ссылка
+        bits[1] = true;
+        bits.At(3) = bits[2];
+        auto ref = bits[4];
+        ref.Flip();
+        assert(bits[1] && !bits[3] && bits[4] && ~bits[5]);
+        try {
+            bits.At(200);
+            assert(false);
+        } catch (const out_of_range&) {
+        }
+
+        assert(bits.FindFirst() == 0 && bits.FindNext(1) == 1 && bits.FindNext(5) == 6);
+        assert(bits.FindNext(199) == 200 && bits.FindNext(500) == 200);
+        bits.PopBack();
+        bits.PopBack();
+        assert(bits.GetSize() == 198 && bits.GetWordCount() == 4);
+        while (bits.GetSize() > 128) {
+            bits.PopBack();
+        }
+        assert(bits.GetWordCount() == 2);
+    }
+    {
+        // Resize и заполнение целыми словами; хвост последнего слова всегда нулевой
+        SimpleBitVector<> bits(70, true);
+        assert(bits.Count() == 70 && bits.GetWords()[1] == 0x3F);
+        bits.Resize(100);
+        assert(bits.Count() == 70 && !bits[99]);
+        bits.Resize(300, true);
+        assert(bits.Count() == 270 && bits[99] == false && bits[100] && bits[299]);
+        bits.Resize(65);
+        assert(bits.Count() == 65 && bits.GetWordCount() == 2 && bits.GetWords()[1] == 1);
+        bits.Fill(false);
+        assert(bits.Count() == 0 && bits.FindFirst() == 65);
+        bits.Fill(true);
+        assert(bits.Count() == 65);
+        bits.Clear();
+        assert(bits.IsEmpty() && bits.Count() == 0);
+
+        // AppendWord добавляет до 64 битов за раз с любого смещения
+        SimpleBitVector<> words;
+        words.AppendWord(0b1011, 4);
+        words.AppendWord(~uint64_t{0});
+        words.AppendWord(0xFF, 3);
+        assert(words.GetSize() == 71 && words.Count() == 3 + 64 + 3);
+        assert(words[0] && !words[2] && words[3] && words[4] && words[67] && words[70]);
+        assert((SimpleBitVector<>{true, false, true} == SimpleBitVector<>{true, false, true}));
+        assert((SimpleBitVector<>{true, false} != SimpleBitVector<>{true, false, false}));
+    }
+    {
+        // Побитовые операции по словам, включая хвосты длиной не кратной векторному регистру
+        const size_t size = 64 * 11 + 13;
+        SimpleBitVector<> a(size), b(size);
+        for (size_t i = 0; i < size; ++i) {
+            a[i] = i % 2 == 0;
+            b[i] = i % 3 == 0;
+        }
+        const auto both = a & b;
+        const auto any = a | b;
+        const auto one = a ^ b;
+        const auto neither = ~any;
+        for (size_t i = 0; i < size; ++i) {
+            assert(both[i] == (i % 6 == 0));
+            assert(any[i] == (i % 2 == 0 || i % 3 == 0));
+            assert(one[i] == ((i % 2 == 0) != (i % 3 == 0)));
+            assert(neither[i] == !any[i]);
+        }
+        assert(any.Count() + neither.Count() == size);
+        assert(neither.GetWords()[neither.GetWordCount() - 1] >> 13 == 0);
+        SimpleBitVector<> c(size - 1);
+        try {
+            c &= a;
+            assert(false);
+        } catch (const invalid_argument&) {
+        }
+    }
+    cout << "Done!" << endl;
+}
+
+// Таблицы, построенные на этапе компиляции
+constexpr SimpleVector<int> BuildPrimes(int limit) {
+    SimpleVector<int> primes;
+    for (int candidate = 2; candidate < limit; ++candidate) {
+        bool prime = true;
+        for (int p : primes) {
+            prime = prime && candidate % p != 0;
+        }
+        if (prime) {
+            primes.PushBack(candidate);
+        }
+    }
+    return primes;
+}
+
+constexpr bool CheckConstexprOperations() {
+    SimpleVector<int> v{5, 1, 4};
+    v.Insert(v.begin() + 1, 7);
+    v.Insert(v.begin(), 2, 9);
+    v.EmplaceBack(3);
+    v.Erase(v.begin() + 2);
+    v.Erase(v.begin(), v.begin() + 1);
+    bool ok = v == SimpleVector<int>{9, 7, 1, 4, 3};
+    v.Resize(6);
+    ok = ok && v.GetSize() == 6 && v[5] == 0;
+    v.ShrinkToFit();
+    ok = ok && v.GetCapacity() == 6;
+    std::sort(v.begin(), v.end());
+    ok = ok && v == SimpleVector<int>{0, 1, 3, 4, 7, 9};
+    ok = ok && SimpleVector<int>{0, 1} < v && v < SimpleVector<int>{0, 2} && FindFirstMismatch(v, SimpleVector<int>{0, 1, 5}) == 2;
+
+    // Элементы, которые нельзя переносить побайтово
+    SimpleVector<SimpleVector<int>> nested;
+    for (int i = 0; i < 5; ++i) {
+        nested.Insert(nested.begin(), SimpleVector<int>(i, i));
+    }
+    nested.Erase(nested.begin() + 1);
+    SimpleVector<SimpleVector<int>> copy = nested;
+    ok = ok && copy == nested && copy.GetSize() == 4 && copy[0].GetSize() == 4 && copy[1].GetSize() == 2;
+    copy[3].PushBack(1);
+    return ok && nested < copy;
+}
+
+constexpr auto FROZEN_PRIMES = FreezeSimpleVector<[] { return BuildPrimes(50); }>();
+
+void TestConstexprSimpleVector() {
+    cout << "Test constexpr" << endl;
+    static_assert(BuildPrimes(30).GetSize() == 10);
+    static_assert(BuildPrimes(30)[9] == 29);
+    static_assert(BuildPrimes(20) != BuildPrimes(30));
+    static_assert(CheckConstexprOperations());
+    static_assert(FROZEN_PRIMES.size() == 15 && FROZEN_PRIMES[0] == 2 && FROZEN_PRIMES[14] == 47);
+
+    // Те же функции во время выполнения дают те же результаты
+    const SimpleVector<int> primes = BuildPrimes(50);
+    assert(equal(primes.begin(), primes.end(), FROZEN_PRIMES.begin(), FROZEN_PRIMES.end()));
+    assert(CheckConstexprOperations());
+    cout << "Done!" << endl;
+}
+
+// Сумма среза: функция принимает и вектор целиком, и его часть без копирования
+int SumView(SimpleVectorView<int> items) {
+    return accumulate(items.begin(), items.end(), 0);
+}
+
+void TestSimpleVectorView() {
+    cout << "Test views" << endl;
+    SimpleVector<int> v{1, 2, 3, 4, 5, 6};
+    const SimpleVector<int>& cv = v;
+    vector<int> std_vector{1, 2, 3};
+    int c_array[] = {4, 5, 6};
+    StaticVector<int, 4> static_vector{7, 8};
+
+    assert(SumView(v) == 21 && SumView(cv) == 21);
+    assert(SumView(std_vector) == 6 && SumView(c_array) == 15 && SumView(static_vector) == 15);
+
+    SimpleVectorView<int> all = v;
+    assert(all.data() == v.begin() && all.GetSize() == 6);
+    const SimpleVectorView<int> middle = all.Subview(1, 3);
+    assert(middle.GetSize() == 3 && middle[0] == 2 && middle.At(2) == 4);
+    assert(SumView(all.First(2)) == 3 && SumView(all.Last(2)) == 11 && SumView(all.Subview(4)) == 11);
+    assert(all.Subview(6).IsEmpty() && all.First(0).IsEmpty());
+    try {
+        all.Subview(4, 3);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+    try {
+        middle.At(3);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    // Изменяемый срез меняет элементы, но не размер вектора
+    MutableSimpleVectorView<int> tail = MutableSimpleVectorView<int>(v).Last(3);
+    for (int& item : tail) {
+        item *= 10;
+    }
+    assert((v == SimpleVector<int>{1, 2, 3, 40, 50, 60}));
+    MutableSimpleVectorView<int> c_view = c_array;
+    c_view[0] = 0;
+    assert(c_array[0] == 0 && SumView(c_view) == 11);
+
+    // Сравнения, в том числе изменяемого среза с константным
+    SimpleVectorView<int> std_view = std_vector;
+    assert(all.First(3) == std_view && tail != std_view);
+    assert(std_view < tail && tail > std_view && all.First(2) <= std_view && std_view >= all.First(3));
+    assert(SimpleVectorView<int>() == SimpleVectorView<int>(cv.end(), cv.end()));
+
+    static_assert(!is_constructible_v<MutableSimpleVectorView<int>, const SimpleVector<int>&>);
+    static_assert(!is_constructible_v<MutableSimpleVectorView<int>, SimpleVectorView<int>>);
+    static_assert(sizeof(SimpleVectorView<int>) == sizeof(int*) + sizeof(size_t));
+    cout << "Done!" << endl;
+}
+
+// Элемент, перемещение которого может бросить исключение, а копирование бросает,
+// когда исчерпан счётчик COPIES_LEFT. Перемещённый элемент помечается значением -1
+struct ThrowingMove {
+    inline static int COPIES_LEFT = 1'000'000;
+
+    explicit ThrowingMove(int v)
+        : value(v) {
+    }
+
+    ThrowingMove(const ThrowingMove& other)
+        : value(other.value) {
+        if (COPIES_LEFT-- == 0) {
+            throw runtime_error("copy");
+        }
+    }
+
+    ThrowingMove(ThrowingMove&& other) noexcept(false)
+        : value(exchange(other.value, -1)) {
+    }
+
+    ThrowingMove& operator=(const ThrowingMove&) = default;
+    ThrowingMove& operator=(ThrowingMove&&) = default;
+
+    int value;
+};
+
+void TestAssignment() {
+    cout << "Test assignment" << endl;
+    {
+        // Перемещение забирает буфер, источник получает пустой буфер приёмника
+        SimpleVector<int> a(1000, 1);
+        SimpleVector<int> b(10, 2);
+        const int* const a_data = a.begin();
+        const int* const b_data = b.begin();
+        b = move(a);
+        assert(b.begin() == a_data && b.GetSize() == 1000 && b[999] == 1);
+        assert(a.IsEmpty() && a.begin() == b_data && a.GetCapacity() == 10);
+
+        // Копирование пишет в имеющийся буфер, если его хватает
+        a = SimpleVector<int>{1, 2, 3};
+        const int* const reused = b.begin();
+        b = a;
+        assert(b == a && b.begin() == reused && b.GetCapacity() == 1000);
+        a.Resize(8);
+        b = a;
+        assert(b == a && b.begin() == reused);
+        b.ShrinkToFit();
+        a.Resize(20);
+        b = a;
+        assert(b == a && b.GetCapacity() == 20);
+
+        SimpleVector<string> words{"a"s, "b"s};
+        SimpleVector<string> other{"c"s};
+        other = move(words);
+        assert((other == SimpleVector<string>{"a"s, "b"s}) && words.IsEmpty());
+        words = other;
+        assert(words == other);
+    }
+    {
+        // Буфер из другого ресурса не забирается: элементы перемещаются, аллокатор остаётся
+        using PmrVector = SimpleVector<int, pmr::polymorphic_allocator<int>>;
+        pmr::monotonic_buffer_resource first;
+        pmr::monotonic_buffer_resource second;
+        PmrVector a({1, 2, 3}, pmr::polymorphic_allocator<int>(&first));
+        PmrVector b{pmr::polymorphic_allocator<int>(&second)};
+        b = move(a);
+        assert((b == PmrVector{1, 2, 3}) && a.IsEmpty());
+        assert(b.GetAllocator().resource() == &second);
+        PmrVector c{pmr::polymorphic_allocator<int>(&second)};
+        const int* const b_data = b.begin();
+        c = move(b);
+        assert(c.begin() == b_data && b.IsEmpty());
+    }
+    {
+        // Перевыделение копирует элементы с бросающим перемещением: при исключении вектор цел
+        SimpleVector<ThrowingMove> v;
+        v.Reserve(4);
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(i);
+        }
+        const ThrowingMove* const data = v.begin();
+        ThrowingMove::COPIES_LEFT = 3;
+        try {
+            v.PushBack(ThrowingMove(4));
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        ThrowingMove::COPIES_LEFT = 1;
+        try {
+            v.Reserve(100);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        ThrowingMove::COPIES_LEFT = 1'000'000;
+        assert(v.GetSize() == 4 && v.GetCapacity() == 4 && v.begin() == data);
+        for (int i = 0; i < 4; ++i) {
+            assert(v[i].value == i);
+        }
+        v.PushBack(ThrowingMove(4));
+        assert(v.GetSize() == 5 && v[0].value == 0 && v[4].value == 4);
+    }
+    cout << "Done!" << endl;
+}
+
+void TestSmallSimpleVectorInline() {
+    cout << "Test SmallSimpleVector inline storage" << endl;
+    SmallSimpleVector<int, 4> v;
+    assert(v.IsEmpty() && v.IsInline());
+    assert(v.GetCapacity() == 4);
+    for (int i = 0; i < 4; ++i) {
+        v.PushBack(i);
+    }
+    assert(v.IsInline());
+    const int* const inline_begin = v.begin();
+    assert(reinterpret_cast<const char*>(inline_begin) >= reinterpret_cast<const char*>(&v)
+           && reinterpret_cast<const char*>(inline_begin) < reinterpret_cast<const char*>(&v + 1));
+
+    v.Insert(v.begin() + 1, 42);
+    assert(!v.IsInline());
+    assert((v == SmallSimpleVector<int, 4>{0, 42, 1, 2, 3}));
+    v.Erase(v.begin());
+    assert((v == SmallSimpleVector<int, 4>{42, 1, 2, 3}));
+    v.Resize(10);
+    assert(v.GetSize() == 10 && v[9] == 0);
+    v.PushBack(v[0]);
+    assert(v[10] == 42);
+    assert(v.At(1) == 1);
+
+    SmallSimpleVector<int, 4> small{1, 2};
+    assert(small < v);
+    assert(small != v);
+    cout << "Done!" << endl;
+}
+
+void TestSmallSimpleVectorMoveSwap() {
+    cout << "Test SmallSimpleVector move and swap" << endl;
+    {
+        SmallSimpleVector<string, 2> inline_vector{"a"s, "b"s};
+        SmallSimpleVector<string, 2> heap_vector{"c"s, "d"s, "e"s};
+        assert(inline_vector.IsInline() && !heap_vector.IsInline());
+        const string* const heap_begin = heap_vector.begin();
+
+        inline_vector.swap(heap_vector);
+        assert((inline_vector == SmallSimpleVector<string, 2>{"c"s, "d"s, "e"s}));
+        assert((heap_vector == SmallSimpleVector<string, 2>{"a"s, "b"s}));
+        assert(inline_vector.begin() == heap_begin);
+        assert(heap_vector.IsInline());
+
+        SmallSimpleVector<string, 2> moved(move(inline_vector));
+        assert(moved.begin() == heap_begin);
+        assert(inline_vector.IsEmpty());
+
+        SmallSimpleVector<string, 2> moved_inline(move(heap_vector));
+        assert(moved_inline.IsInline() && moved_inline[1] == "b"s);
+        assert(heap_vector.IsEmpty());
+
+        moved = move(moved_inline);
+        assert(moved.GetSize() == 2 && moved[0] == "a"s);
+
+        SmallSimpleVector<string, 2> copy = moved;
+        assert(copy == moved);
+    }
+    {
+        SmallSimpleVector<X, 3> v;
+        for (size_t i = 0; i < 5; ++i) {
+            v.PushBack(X(i));
+        }
+        v.Insert(v.begin(), X(10));
+        SmallSimpleVector<X, 3> moved = move(v);
+        assert(moved.GetSize() == 6);
+        assert(moved[0].GetX() == 10 && moved[5].GetX() == 4);
+    }
+    cout << "Done!" << endl;
+}
+
+void TestSmallSimpleVectorSafety() {
+    cout << "Test SmallSimpleVector exception safety and allocators" << endl;
+    {
+        // Рост копирует элементы с бросающим перемещением и разрушает старые
+        // только после успешного переноса: при исключении вектор цел
+        SmallSimpleVector<ThrowingMove, 2> v;
+        v.EmplaceBack(0);
+        v.EmplaceBack(1);
+        ThrowingMove::COPIES_LEFT = 1;
+        try {
+            v.Emplace(v.begin() + 1, 5);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        assert(v.IsInline() && v.GetSize() == 2 && v[0].value == 0 && v[1].value == 1);
+
+        ThrowingMove::COPIES_LEFT = 1'000'000;
+        v.EmplaceBack(2);
+        v.EmplaceBack(3);
+        const ThrowingMove* const data = v.begin();
+        ThrowingMove::COPIES_LEFT = 2;
+        try {
+            v.EmplaceBack(4);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        ThrowingMove::COPIES_LEFT = 0;
+        try {
+            v.Reserve(100);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        ThrowingMove::COPIES_LEFT = 1'000'000;
+        assert(v.GetSize() == 4 && v.GetCapacity() == 4 && v.begin() == data);
+        for (int i = 0; i < 4; ++i) {
+            assert(v[i].value == i);
+        }
+    }
+    {
+        // Буфер из другого ресурса не забирается: элементы перемещаются, аллокатор остаётся
+        using PmrVector = SmallSimpleVector<int, 2, pmr::polymorphic_allocator<int>>;
+        pmr::unsynchronized_pool_resource first;
+        pmr::unsynchronized_pool_resource second;
+        PmrVector a({1, 2, 3}, pmr::polymorphic_allocator<int>(&first));
+        PmrVector b{pmr::polymorphic_allocator<int>(&second)};
+        const int* const a_data = a.begin();
+        b = move(a);
+        assert((b == PmrVector{1, 2, 3}) && a.IsEmpty());
+        assert(b.begin() != a_data && b.GetAllocator().resource() == &second);
+
+        PmrVector c{pmr::polymorphic_allocator<int>(&second)};
+        const int* const b_data = b.begin();
+        c = move(b);
+        assert(c.begin() == b_data && b.IsEmpty());
+
+        PmrVector d({4, 5, 6, 7}, pmr::polymorphic_allocator<int>(&first));
+        c.swap(d);
+        assert((c == PmrVector{4, 5, 6, 7}) && (d == PmrVector{1, 2, 3}));
+        assert(c.GetAllocator().resource() == &second && d.GetAllocator().resource() == &first);
+    }
+    cout << "Done!" << endl;
+}
+
+void TestSegmentedVectorStableReferences() {
+    cout << "Test SegmentedVector stable references" << endl;
+    SegmentedVector<int> v;
+    assert(v.IsEmpty() && v.GetCapacity() == 0);
+    v.PushBack(0);
+    const int* const first = &v[0];
+    vector<const int*> addresses;
+    for (int i = 1; i < 100'000; ++i) {
+        v.PushBack(i);
+        if (i % 1000 == 0) {
+            addresses.push_back(&v[i]);
+        }
+    }
+    // Рост не переносит элементы
+    assert(&v[0] == first);
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        assert(addresses[i] == &v[(i + 1) * 1000]);
+        assert(*addresses[i] == int(i + 1) * 1000);
+    }
+    assert(v.GetSize() == 100'000 && v.GetCapacity() >= 100'000);
+    assert(accumulate(v.begin(), v.end(), 0LL) == 99'999LL * 100'000 / 2);
+    assert(v.At(12345) == 12345);
+    try {
+        v.At(100'000);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+    cout << "Done!" << endl;
+}
+
+void TestSegmentedVectorInterface() {
+    cout << "Test SegmentedVector interface" << endl;
+    {
+        SegmentedVector<string> v(3, "abc");
+        assert(v.GetSize() == 3 && v[2] == "abc");
+        v.Resize(40);
+        assert(v.GetSize() == 40 && v[39].empty());
+        v.PopBack();
+        assert(v.GetSize() == 39);
+        v.Resize(2);
+        assert((v == SegmentedVector<string>{"abc", "abc"}));
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 16);
+        v.Clear();
+        assert(v.IsEmpty() && v.GetCapacity() == 16);
+        v.Reserve(1000);
+        assert(v.GetCapacity() >= 1000);
+    }
+    {
+        SegmentedVector<int> a{1, 2, 3};
+        const vector<int> source(50, 7);
+        SegmentedVector<int> b(source.begin(), source.end());
+        assert(b.GetSize() == 50 && b[49] == 7);
+        assert(a < b && b > a && a != b && a <= a && a >= a);
+
+        SegmentedVector<int> copy(b);
+        assert(copy == b);
+        SegmentedVector<int> moved(std::move(copy));
+        assert(moved == b && copy.IsEmpty());
+        copy = a;
+        assert(copy == a);
+        copy = std::move(moved);
+        assert(copy == b);
+        copy.swap(a);
+        assert((copy == SegmentedVector<int>{1, 2, 3}) && a == b);
+
+        SegmentedVector<int> sized(5);
+        assert(sized.GetSize() == 5 && sized[4] == 0);
+        // Итераторы произвольного доступа работают со стандартными алгоритмами
+        SegmentedVector<int> values{5, 3, 4, 1, 2};
+        sort(values.begin(), values.end());
+        assert((values == SegmentedVector<int>{1, 2, 3, 4, 5}));
+        assert(values.end() - values.begin() == 5);
+        SegmentedVector<int>::ConstIterator it = values.begin();
+        assert(*(it + 2) == 3);
+    }
+    cout << "Done!" << endl;
+}
+
+// Поле, копирование которого бросает исключение для отрицательного значения
+struct SoAThrowingField {
+    SoAThrowingField(int value = 0) : value(value) {
+    }
+
+    SoAThrowingField(const SoAThrowingField& other) : value(other.value) {
+        if (value < 0) {
+            throw runtime_error("negative value");
+        }
+    }
+
+    SoAThrowingField(SoAThrowingField&&) noexcept = default;
+    SoAThrowingField& operator=(const SoAThrowingField&) = default;
+    SoAThrowingField& operator=(SoAThrowingField&&) noexcept = default;
+
+    bool operator==(const SoAThrowingField& other) const {
+        return value == other.value;
+    }
+
+    int value;
+};
+
+namespace soa_test {
+
+// Своя запись для SoAVector: tuple_size и tuple_element специализированы в std,
+// а get объявлен рядом со структурой и находится по ADL
+struct Trade {
+    int id;
+    double price;
+    string venue;
+};
+
+template <size_t I, typename Record>
+    requires is_same_v<remove_cvref_t<Record>, Trade>
+decltype(auto) get(Record&& trade) {
+    if constexpr (I == 0) {
+        return (std::forward<Record>(trade).id);
+    } else if constexpr (I == 1) {
+        return (std::forward<Record>(trade).price);
+    } else {
+        return (std::forward<Record>(trade).venue);
+    }
+}
+
+}  // namespace soa_test
+
+template <>
+struct std::tuple_size<soa_test::Trade> : integral_constant<size_t, 3> {};
+
+template <size_t I>
+struct std::tuple_element<I, soa_test::Trade> : tuple_element<I, tuple<int, double, string>> {};
+
+void TestSoAVectorAccess() {
+    cout << "Test SoAVector access" << endl;
+    SoAVector<int, double, string> v;
+    assert(v.IsEmpty() && v.GetSize() == 0);
+    v.PushBack(make_tuple(1, 1.5, string("one")));
+    v.EmplaceBack(2, 2.5, "two");
+    const tuple<int, double, string> three(3, 3.5, "three");
+    v.PushBack(three);
+    assert(v.GetSize() == 3 && v.GetCapacity() >= 3);
+
+    // operator[] возвращает кортеж ссылок на поля записи
+    auto [id, price, name] = v[1];
+    assert(id == 2 && price == 2.5 && name == "two");
+    price = 20.5;
+    assert(v.Get<1>(1) == 20.5);
+    v[0] = make_tuple(10, 10.5, string("ten"));
+    assert(v.Get<0>(0) == 10 && v.Get<2>(0) == "ten");
+    assert(v[2] == three);
+
+    const auto& cv = v;
+    assert(get<2>(cv[2]) == "three");
+    assert(get<0>(cv.At(1)) == 2);
+    try {
+        cv.At(3);
+        assert(false);
+    } catch (const out_of_range&) {
+    } catch (...) {
+        assert(false);
+    }
+
+    // Поле хранится непрерывным массивом
+    const auto ids = cv.Field<0>();
+    static_assert(is_same_v<decltype(ids), const SimpleVectorView<int>>);
+    assert(ids.GetSize() == 3 && ids[2] == 3);
+    assert(ids.data() + 1 == &cv.Get<0>(1));
+    assert(accumulate(ids.begin(), ids.end(), 0) == 15);
+    for (double& p : v.Field<1>()) {
+        p *= 2;
+    }
+    assert(v.Get<1>(2) == 7.0);
+
+    // Запись может быть любым кортежеподобным объектом
+    SoAVector<int, int> pairs;
+    pairs.PushBack(pair<int, int>(1, 2));
+    pairs.PushBack(array<int, 2>{3, 4});
+    assert(pairs.GetSize() == 2 && pairs.Get<1>(1) == 4);
+
+    // в том числе своя структура с get<I> в её пространстве имён
+    const soa_test::Trade trade{4, 4.5, "four"};
+    v.PushBack(trade);
+    soa_test::Trade moved{5, 5.5, string(100, 'x')};
+    v.Insert(0, move(moved));
+    assert(v.GetSize() == 5 && v.Get<2>(4) == "four" && v.Get<2>(0) == string(100, 'x'));
+    assert(moved.venue.empty() && trade.venue == "four");
+    auto [trade_id, trade_price, trade_venue] = trade;
+    assert(trade_id == 4 && trade_price == 4.5 && trade_venue == "four");
+    cout << "Done!" << endl;
+}
+
+void TestSoAVectorModifiers() {
+    cout << "Test SoAVector modifiers" << endl;
+    {
+        SoAVector<int, string> v{{1, "a"}, {2, "b"}, {4, "d"}};
+        assert(v.Insert(2, make_tuple(3, string("c"))) == 2);
+        assert(v.Insert(0, make_tuple(0, string(""))) == 0);
+        assert(v.Insert(5, make_tuple(5, string("e"))) == 5);
+        assert((v == SoAVector<int, string>{{0, ""}, {1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}, {5, "e"}}));
+
+        assert(v.Erase(0) == 0);
+        assert(v.Erase(1, 3) == 1);
+        assert((v == SoAVector<int, string>{{1, "a"}, {4, "d"}, {5, "e"}}));
+        v.PopBack();
+        assert(v.GetSize() == 2 && v.Get<1>(1) == "d");
+
+        v.Resize(4);
+        assert(v.GetSize() == 4 && v.Get<0>(3) == 0 && v.Get<1>(3).empty());
+        v.Resize(1);
+        assert((v == SoAVector<int, string>{{1, "a"}}));
+
+        v.Reserve(100);
+        assert(v.GetCapacity() >= 100 && v.GetSize() == 1);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 1);
+        v.Clear();
+        assert(v.IsEmpty());
+
+        SoAVector<int, string> other(3);
+        assert(other.GetSize() == 3 && other.Get<0>(2) == 0);
+        v.swap(other);
+        assert(v.GetSize() == 3 && other.IsEmpty());
+        assert(v != other);
+    }
+    {
+        // Если одно из полей бросает исключение, ни один столбец не меняется
+        SoAVector<int, SoAThrowingField> v;
+        v.PushBack(make_tuple(1, SoAThrowingField(1)));
+        const SoAThrowingField bad(-1);
+        try {
+            v.EmplaceBack(2, bad);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        assert(v.GetSize() == 1 && v.Field<0>().GetSize() == 1);
+        try {
+            v.Insert(0, tuple<int, const SoAThrowingField&>(0, bad));
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        assert(v.GetSize() == 1 && v.Get<0>(0) == 1 && v.Field<0>().GetSize() == 1);
+    }
+    cout << "Done!" << endl;
+}
+
+// Сверяет LowerBound и Find множества с std::lower_bound по тем же ключам
+template <typename Set, typename Key>
+void CheckFlatSetLookups(const Set& set, const vector<Key>& probes) {
+    const auto& keys = set.GetKeys();
+    for (const Key& probe : probes) {
+        const auto expected = lower_bound(keys.begin(), keys.end(), probe);
+        assert(set.LowerBound(probe) == expected);
+        assert(set.Contains(probe) == (expected != keys.end() && *expected == probe));
+    }
+}
+
+template <typename Layout>
+void TestFlatSetLayout() {
+    mt19937 generator(42);
+    // Размеры вокруг границ узлов и уровней дерева
+    for (size_t size : {0, 1, 2, 3, 7, 15, 16, 17, 31, 255, 256, 257, 1000, 4097, 100'000}) {
+        vector<int32_t> keys(size);
+        for (auto& key : keys) {
+            key = static_cast<int32_t>(generator() % (size * 4 + 1)) - static_cast<int32_t>(size);
+        }
+        const FlatSet<int32_t, less<int32_t>, Layout> set(keys.begin(), keys.end());
+        const std::set<int32_t> expected(keys.begin(), keys.end());
+        assert(set.GetSize() == expected.size() && equal(set.begin(), set.end(), expected.begin()));
+
+        vector<int32_t> probes;
+        for (int32_t probe = -static_cast<int32_t>(size) - 2; probe <= static_cast<int32_t>(size * 3) + 2;
+             probe += 1 + static_cast<int32_t>(size / 500)) {
+            probes.push_back(probe);
+        }
+        CheckFlatSetLookups(set, probes);
+    }
+    {
+        // Ключи, для которых нет SIMD-ядра, и обратный порядок
+        vector<double> keys;
+        for (int i = 0; i < 5000; ++i) {
+            keys.push_back(i * 0.5);
+        }
+        FlatSet<double, greater<double>, Layout> set(keys.begin(), keys.end());
+        assert(*set.begin() == 2499.5 && *set.LowerBound(100.25) == 100.0);
+        assert(set.LowerBound(-1.0) == set.end() && set.Contains(0.5));
+
+        FlatSet<string, less<string>, Layout> words{"pear", "apple", "plum", "fig", "apple"};
+        assert(words.GetSize() == 4 && *words.begin() == "apple");
+        assert(words.Contains("fig") && !words.Contains("kiwi"));
+        assert(*words.LowerBound("grape") == "pear");
+    }
+    {
+        FlatSet<float, less<float>, Layout> floats{3.5f, -1.0f, 2.0f};
+        assert(*floats.LowerBound(0.0f) == 2.0f && floats.Contains(-1.0f));
+    }
+}
+
+void TestFlatSetModifiers() {
+    cout << "Test FlatSet modifiers" << endl;
+    FlatSet<int, less<int>, BTreeLayout<>> set{5, 1, 3};
+    assert(set.Insert(4).second && !set.Insert(4).second);
+    assert(*set.Insert(0).first == 0);
+    assert((set == FlatSet<int, less<int>, BTreeLayout<>>{0, 1, 3, 4, 5}));
+    assert(set.Erase(3) == 1 && set.Erase(3) == 0);
+    assert(set.Count(1) == 1 && set.Count(3) == 0);
+
+    // Пачка с повторами внутри себя и с уже имеющимися ключами сливается за один проход
+    const vector<int> batch{9, 1, 7, 7, -2, 5, 8, 9};
+    assert(set.InsertBatch(batch.begin(), batch.end()) == 4);
+    assert((set == FlatSet<int, less<int>, BTreeLayout<>>{-2, 0, 1, 4, 5, 7, 8, 9}));
+    assert(set.Find(7) != set.end() && set.Find(6) == set.end());
+
+    // Большая пачка перестраивает индекс
+    vector<int> many(100'000);
+    for (size_t i = 0; i < many.size(); ++i) {
+        many[i] = static_cast<int>(i * 2);
+    }
+    assert(set.InsertBatch(many.begin(), many.end()) == many.size() - 3);
+    assert(set.GetSize() == 100'005 && set.Contains(199'998) && !set.Contains(199'997));
+    assert(set.GetIndexMemory() > 0);
+    set.Clear();
+    assert(set.IsEmpty() && !set.Contains(0) && set.LowerBound(0) == set.end());
+    cout << "Done!" << endl;
+}
+
+void TestFlatMap() {
+    cout << "Test FlatMap" << endl;
+    using Map = FlatMap<int, string, less<int>, EytzingerLayout>;
+    Map map{{3, "three"}, {1, "one"}, {3, "drei"}, {2, "two"}};
+    assert(map.GetSize() == 3 && map.At(3) == "three");
+    assert(map.Find(4) == nullptr && *map.Find(1) == "one");
+    try {
+        map.At(4);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    assert(map.Insert(4, "four").second && !map.Insert(4, "vier").second);
+    assert(map[4] == "four");
+    map[0] = "zero";
+    assert(map.GetKeys()[0] == 0 && map.GetValues()[0] == "zero");
+    // Значения можно менять, но не их число: вектор значений отдаётся представлением
+    static_assert(is_same_v<decltype(map.GetValues()), MutableSimpleVectorView<string>>);
+    assert(!map.InsertOrAssign(1, "uno") && map.At(1) == "uno");
+    assert(map.Erase(2) == 1 && !map.Contains(2));
+
+    const vector<pair<int, string>> batch{{7, "seven"}, {1, "eins"}, {5, "five"}, {7, "sieben"}};
+    assert(map.InsertBatch(batch.begin(), batch.end()) == 2);
+    assert((map == Map{{0, "zero"}, {1, "uno"}, {3, "three"}, {4, "four"}, {5, "five"}, {7, "seven"}}));
+
+    // Большой словарь: поиск через все раскладки даёт одинаковые ответы
+    SimpleVector<pair<uint64_t, uint64_t>> items;
+    for (uint64_t i = 0; i < 50'000; ++i) {
+        items.PushBack({i * 7919 % 100'003, i});
+    }
+    const FlatMap<uint64_t, uint64_t, less<uint64_t>, BTreeLayout<>> tree(items.begin(), items.end());
+    const FlatMap<uint64_t, uint64_t, less<uint64_t>, EytzingerLayout> eytzinger(items.begin(), items.end());
+    const FlatMap<uint64_t, uint64_t> sorted(std::move(items));
+    for (uint64_t key = 0; key < 100'010; key += 3) {
+        const uint64_t* expected = sorted.Find(key);
+        const uint64_t* from_tree = tree.Find(key);
+        const uint64_t* from_eytzinger = eytzinger.Find(key);
+        assert((expected == nullptr) == (from_tree == nullptr) && (expected == nullptr) == (from_eytzinger == nullptr));
+        assert(expected == nullptr || (*expected == *from_tree && *expected == *from_eytzinger));
+    }
+    cout << "Done!" << endl;
+}
+
+// Раскладка, индекс которой бросает исключение при построении, пока поднят флаг fail
+struct ThrowingLayout {
+    static inline bool fail = false;
+
+    template <typename Key, typename Compare>
+    class Index : public SortedLayout::Index<Key, Compare> {
+    public:
+        void Build(const Key* /*keys*/, size_t /*size*/) {
+            if (fail) {
+                throw bad_alloc();
+            }
+        }
+    };
+};
+
+void TestFlatContainersSafety() {
+    cout << "Test FlatSet and FlatMap index failures" << endl;
+    // Длинные строки: перемещённая строка пуста, и потерянный ключ будет заметен
+    const string a(32, 'a'), b(32, 'b'), c(32, 'c'), d(32, 'd'), e(32, 'e');
+    {
+        using Set = FlatSet<string, less<string>, ThrowingLayout>;
+        Set set{a, c, e};
+        const Set expected = set;
+        ThrowingLayout::fail = true;
+        const vector<string> batch{d, b};
+        try {
+            set.InsertBatch(batch.begin(), batch.end());
+            assert(false);
+        } catch (const bad_alloc&) {
+        }
+        assert(set == expected);
+        try {
+            set.Insert(b);
+            assert(false);
+        } catch (const bad_alloc&) {
+        }
+        assert(set == expected);
+        try {
+            set.Erase(c);
+            assert(false);
+        } catch (const bad_alloc&) {
+        }
+        assert(set == expected && set.Contains(c));
+        ThrowingLayout::fail = false;
+        assert(set.InsertBatch(batch.begin(), batch.end()) == 2 && set.Erase(a) == 1);
+        assert((set == Set{b, c, d, e}));
+    }
+    {
+        using Map = FlatMap<string, string, less<string>, ThrowingLayout>;
+        Map map{{a, e}, {c, c}, {e, a}};
+        const Map expected = map;
+        ThrowingLayout::fail = true;
+        const vector<pair<string, string>> batch{{d, d}, {b, b}};
+        try {
+            map.InsertBatch(batch.begin(), batch.end());
+            assert(false);
+        } catch (const bad_alloc&) {
+        }
+        assert(map == expected);
+        try {
+            map.Insert(b, b);
+            assert(false);
+        } catch (const bad_alloc&) {
+        }
+        assert(map == expected);
+        try {
+            map.Erase(c);
+            assert(false);
+        } catch (const bad_alloc&) {
+        }
+        assert(map == expected && map.At(c) == c);
+        ThrowingLayout::fail = false;
+        assert(map.InsertBatch(batch.begin(), batch.end()) == 2 && map.Erase(a) == 1);
+        assert((map == Map{{b, b}, {c, c}, {d, d}, {e, a}}));
+    }
+    {
+        // Некопируемые значения: имеющиеся пары только перемещаются, в том числе обратно при сбое
+        const auto make_batch = [](initializer_list<int> keys) {
+            vector<pair<int, unique_ptr<int>>> batch;
+            for (int key : keys) {
+                batch.emplace_back(key, make_unique<int>(key * 10));
+            }
+            return batch;
+        };
+        const auto check = [](const auto& map, initializer_list<int> keys) {
+            assert(map.GetSize() == keys.size());
+            for (int key : keys) {
+                assert(map.Contains(key) && *map.At(key) == key * 10);
+            }
+        };
+        FlatMap<int, unique_ptr<int>, less<int>, ThrowingLayout> map;
+        auto batch = make_batch({5, 1, 3});
+        assert(map.InsertBatch(make_move_iterator(batch.begin()), make_move_iterator(batch.end())) == 3);
+        ThrowingLayout::fail = true;
+        batch = make_batch({4, 2, 6});
+        try {
+            map.InsertBatch(make_move_iterator(batch.begin()), make_move_iterator(batch.end()));
+            assert(false);
+        } catch (const bad_alloc&) {
+        }
+        ThrowingLayout::fail = false;
+        check(map, {1, 3, 5});
+
+        FlatMap<int, unique_ptr<int>, less<int>, EytzingerLayout> eytzinger;
+        batch = make_batch({5, 1, 3});
+        assert(eytzinger.InsertBatch(make_move_iterator(batch.begin()), make_move_iterator(batch.end())) == 3);
+        batch = make_batch({4, 3, 2});
+        assert(eytzinger.InsertBatch(make_move_iterator(batch.begin()), make_move_iterator(batch.end())) == 2);
+        check(eytzinger, {1, 2, 3, 4, 5});
+    }
+    cout << "Done!" << endl;
+}
+
+void TestFlatSetLayouts() {
+    cout << "Test FlatSet layouts" << endl;
+    TestFlatSetLayout<SortedLayout>();
+    TestFlatSetLayout<EytzingerLayout>();
+    TestFlatSetLayout<BTreeLayout<>>();
+    TestFlatSetLayout<BTreeLayout<16>>();
+    cout << "Done!" << endl;
+}
+
+void TestStaticVectorBasics() {
+    cout << "Test StaticVector basics" << endl;
+    StaticVector<int, 8> v;
+    assert(v.IsEmpty() && v.GetCapacity() == 8);
+    for (int i = 0; i < 5; ++i) {
+        assert(v.PushBack(i));
+    }
+    assert(reinterpret_cast<const char*>(v.begin()) >= reinterpret_cast<const char*>(&v)
+           && reinterpret_cast<const char*>(v.end()) <= reinterpret_cast<const char*>(&v + 1));
+
+    v.Insert(v.begin() + 1, 42);
+    assert((v == StaticVector<int, 8>{0, 42, 1, 2, 3, 4}));
+    v.Insert(v.begin(), 2, v[1]);
+    assert((v == StaticVector<int, 8>{42, 42, 0, 42, 1, 2, 3, 4}) && v.IsFull());
+    v.Erase(v.begin() + 2);
+    v.Erase(v.begin(), v.begin() + 2);
+    assert((v == StaticVector<int, 8>{42, 1, 2, 3, 4}));
+    v.EmplaceBack(v[0]) = 7;
+    assert(v.GetSize() == 6 && v[5] == 7);
+    const int extra[] = {8, 9};
+    v.Insert(v.begin(), begin(extra), end(extra));
+    assert(v[0] == 8 && v[1] == 9 && v.IsFull());
+    v.Resize(3);
+    assert((v == StaticVector<int, 8>{8, 9, 42}));
+    v.Resize(5);
+    assert(v[4] == 0 && v.At(2) == 42);
+    try {
+        v.At(5);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+    v.PopBack();
+    assert(v.GetSize() == 4);
+    assert((StaticVector<int, 8>{8, 9} < v) && (v != StaticVector<int, 8>{}));
+
+    // Тривиально копируемый вектор переносится memcpy
+    static_assert(is_trivially_copyable_v<StaticVector<int, 8>>);
+    static_assert(!is_trivially_copyable_v<StaticVector<string, 8>>);
+    StaticVector<int, 8> copy;
+    memcpy(static_cast<void*>(&copy), &v, sizeof(v));
+    assert(copy == v);
+    cout << "Done!" << endl;
+}
+
+void TestStaticVectorOverflow() {
+    cout << "Test StaticVector overflow" << endl;
+    {
+        StaticVector<int, 3> v{1, 2, 3};
+        try {
+            v.PushBack(4);
+            assert(false);
+        } catch (const length_error&) {
+        }
+        try {
+            StaticVector<int, 3> too_big(4);
+            assert(false);
+        } catch (const length_error&) {
+        }
+        assert((v == StaticVector<int, 3>{1, 2, 3}));
+    }
+    {
+        using Vector = StaticVector<string, 3, RejectOnOverflow>;
+        Vector v{"a"s, "b"s};
+        assert(v.PushBack("c"s));
+        assert(!v.PushBack("d"s));
+        assert(v.EmplaceBack("e") == nullptr);
+        assert(v.Insert(v.begin(), "f"s) == nullptr);
+        assert(v.Insert(v.begin(), 1, "g"s) == nullptr);
+        assert(!v.Resize(4));
+        assert((v == Vector{"a"s, "b"s, "c"s}));
+
+        // Пустая вставка в конец полного вектора успешна и возвращает end(), а не отказ
+        const vector<string> none;
+        assert(v.Insert(v.end(), 0, "h"s) == v.end());
+        assert(v.Insert(v.end(), none.begin(), none.end()) == v.end());
+        assert(v.Append(none.begin(), none.end()));
+        istringstream empty_words;
+        assert(v.Insert(v.end(), istream_iterator<string>(empty_words), istream_iterator<string>()) == v.end());
+        assert(v.Insert(v.end(), 1, "h"s) == nullptr);
+        const vector<string> one{"h"s};
+        assert(!v.Append(one.begin(), one.end()));
+
+        // Однопроходный диапазон, не поместившийся целиком, откатывается
+        v.Erase(v.begin());
+        istringstream words("x y z");
+        assert(v.Insert(v.begin(), istream_iterator<string>(words), istream_iterator<string>()) == nullptr);
+        assert((v == Vector{"b"s, "c"s}));
+        istringstream word("x");
+        assert(v.Insert(v.begin(), istream_iterator<string>(word), istream_iterator<string>()) == v.begin());
+        assert((v == Vector{"x"s, "b"s, "c"s}));
+        assert(Vector(5).IsEmpty());
+    }
+    {
+        StaticVector<int, 2, AbortOnOverflow> v;
+        v.EmplaceBack(1);
+        v.PushBack(2);
+        assert(v.IsFull());
+    }
+    {
+        // Огромное count не переполняет size_ + count: вставка отклоняется политикой
+        const vector<int> source(4, 7);
+        StaticVector<int, 4> thrower{1};
+        try {
+            thrower.Insert(thrower.cend(), numeric_limits<size_t>::max(), 7);
+            assert(false);
+        } catch (const length_error&) {
+        }
+        assert((thrower == StaticVector<int, 4>{1}));
+
+        StaticVector<int, 4, RejectOnOverflow> rejecter{1};
+        assert(rejecter.Insert(rejecter.cend(), numeric_limits<size_t>::max(), 7) == nullptr);
+        assert(rejecter.Insert(rejecter.cend(), source.begin(), source.end()) == nullptr);
+        assert((rejecter == StaticVector<int, 4, RejectOnOverflow>{1}));
+#if defined(__unix__) || defined(__APPLE__)
+        const pid_t child = fork();
+        if (child == 0) {
+            // Сообщение assert из дочернего процесса не нужно в выводе тестов
+            freopen("/dev/null", "w", stderr);
+            StaticVector<int, 4, AbortOnOverflow> aborter{1};
+            aborter.Insert(aborter.cend(), numeric_limits<size_t>::max(), 7);
+            _exit(0);
+        }
+        int status = 0;
+        assert(child > 0 && waitpid(child, &status, 0) == child);
+        assert(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+#endif
+    }
+    cout << "Done!" << endl;
+}
+
+void TestStaticVectorMoveSwap() {
+    cout << "Test StaticVector copy, move and swap" << endl;
+    using Vector = StaticVector<string, 4>;
+    Vector a{"a"s, "b"s, "c"s};
+    Vector b{"d"s};
+    a.swap(b);
+    assert((a == Vector{"d"s}) && (b == Vector{"a"s, "b"s, "c"s}));
+
+    Vector copy = b;
+    assert(copy == b);
+    copy = a;
+    assert(copy == a);
+    copy = b;
+    assert(copy == b);
+
+    Vector moved(move(copy));
+    assert(moved == b && copy.IsEmpty());
+    a = move(moved);
+    assert(a == b && moved.IsEmpty());
+
+    StaticVector<X, 4> items;
+    for (size_t i = 0; i < 3; ++i) {
+        items.PushBack(X(i));
+    }
+    items.Insert(items.begin(), X(10));
+    items.Erase(items.begin() + 1);
+    assert(items.GetSize() == 3 && items[0].GetX() == 10 && items[2].GetX() == 2);
+    StaticVector<X, 4> moved_items = move(items);
+    assert(moved_items.GetSize() == 3 && items.IsEmpty());
+    cout << "Done!" << endl;
+}
+
+#ifdef SIMPLE_VECTOR_STATS
+void TestStats() {
+    cout << "Test allocation statistics" << endl;
+    using Vector = SimpleVector<int, MallocAllocator<int>, ExactGrowth>;
+    {
+        Vector v(4);
+        v.PushBack(1);
+        v.PushBack(2);
+        v.Insert(v.begin(), 3);
+        v.Erase(v.begin() + 1);
+        v.Reserve(100);
+    }
+    const auto stats = Vector::GetStats();
+    assert(stats.allocations == 5);
+    assert(stats.reallocations == 4);
+    assert(stats.bytes_allocated == (4 + 5 + 6 + 7 + 100) * sizeof(int));
+    // Рост: 4 + 5 + 6 элементов и 6 при Reserve, сдвиги: 6 при вставке и 5 при удалении
+    assert(stats.elements_relocated == 4 + 5 + 6 + 6 + 6 + 5);
+    assert(stats.peak_capacity == 100);
+    // Reserve оставил пустую ячейку старого буфера, деструктор — 94 ячейки нового
+    assert(stats.wasted_capacity == 1 + 94);
+
+    ostringstream out;
+    DumpSimpleVectorStats(out);
+    assert(out.str().find("SimpleVector<int") != string::npos);
+    cout << "Done!" << endl;
+}
+#endif
+
+void Test11() {
+#ifdef SIMPLE_VECTOR_STATS
+    TestStats();
+#endif
+}
+
+void Test12() {
+    TestSimdComparison();
+}
+
+void Test13() {
+    TestThreadPool();
+    TestParallelOperations();
+}
+
+void Test14() {
+#if defined(__linux__)
+    TestHugePageAllocator();
+#endif
+}
+
+void Test15() {
+#if defined(__unix__) || defined(__APPLE__)
+    TestMappedSimpleVector();
+#endif
+}
+
+void Test16() {
+    TestSerialization();
+}
+
+void Test17() {
+    TestConcurrentSimpleVector();
+}
+
+void Test18() {
+    TestAlignedVector();
+}
+
+void Test19() {
+    TestCowSimpleVector();
+}
+
+void Test20() {
+    TestSimpleBitVector();
+}
+
+void Test21() {
+    TestConstexprSimpleVector();
+}
+
+void Test22() {
+    TestSimpleVectorView();
+}
+
+void Test23() {
+    TestAssignment();
+}
+
+void Test24() {
+    TestSmallSimpleVectorInline();
+    TestSmallSimpleVectorMoveSwap();
+    TestSmallSimpleVectorSafety();
+}
+
+void Test25() {
+    TestSegmentedVectorStableReferences();
+    TestSegmentedVectorInterface();
+}
+
+void Test26() {
+    TestSoAVectorAccess();
+    TestSoAVectorModifiers();
+}
+
+void Test27() {
+    TestFlatSetLayouts();
+    TestFlatSetModifiers();
+    TestFlatMap();
+    TestFlatContainersSafety();
+}
+
+void Test28() {
+    TestStaticVectorBasics();
+    TestStaticVectorOverflow();
+    TestStaticVectorMoveSwap();
+}